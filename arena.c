@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+#include "arena.h"
+
+#define ARENA_ALIGNMENT alignof(max_align_t)
+
+static size_t align_size(size_t size){
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+// adds a block big enough for size bytes, blocks grow geometrically
+static Arena_block *arena_add_block(Arena *arena, size_t size){
+    size_t block_size = ARENA_FIRST_BLOCK_SIZE;
+    if(arena->current != NULL){
+        block_size = arena->current->size * 2;
+    }
+    while(block_size < size){
+        block_size *= 2;
+    }
+
+    Arena_block *block = malloc(sizeof(Arena_block) + block_size);
+    if(block == NULL){
+        return NULL;
+    }
+
+    block->previous = arena->current;
+    block->size = block_size;
+    block->used = 0;
+    arena->current = block;
+
+    return block;
+}
+
+Arena *arena_create(){
+    Arena *arena = malloc(sizeof(Arena));
+    if(arena == NULL){
+        return NULL;
+    }
+
+    arena->current = NULL;
+    arena->last_allocation = NULL;
+    arena->allocated = 0;
+
+    return arena;
+}
+
+// returns NULL only if the system runs out of memory
+void *arena_alloc(Arena *arena, size_t size){
+    size = align_size(size);
+
+    Arena_block *block = arena->current;
+    if(block == NULL || block->size - block->used < size){
+        block = arena_add_block(arena, size);
+        if(block == NULL){
+            return NULL;
+        }
+    }
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+    arena->allocated += size;
+    arena->last_allocation = ptr;
+
+    return ptr;
+}
+
+// resizes an allocation, the last one is extended in place, anything else is copied
+void *arena_grow(Arena *arena, void *ptr, size_t old_size, size_t new_size){
+    if(ptr == NULL){
+        return arena_alloc(arena, new_size);
+    }
+    if(new_size <= old_size){
+        return ptr;
+    }
+
+    Arena_block *block = arena->current;
+    if(ptr == arena->last_allocation){
+        size_t offset = (char *)ptr - block->data;
+        size_t aligned_new_size = align_size(new_size);
+        if(block->size - offset >= aligned_new_size){
+            arena->allocated += aligned_new_size - (block->used - offset);
+            block->used = offset + aligned_new_size;
+            return ptr;
+        }
+    }
+
+    void *new_ptr = arena_alloc(arena, new_size);
+    if(new_ptr == NULL){
+        return NULL;
+    }
+    memcpy(new_ptr, ptr, old_size);
+
+    return new_ptr;
+}
+
+char *arena_strndup(Arena *arena, const char *str, size_t length){
+    char *copy = arena_alloc(arena, length + 1);
+    if(copy == NULL){
+        return NULL;
+    }
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+
+    return copy;
+}
+
+// frees everything allocated from the arena at once
+void arena_destroy(Arena *arena){
+    if(arena == NULL){
+        return;
+    }
+
+    Arena_block *block = arena->current;
+    while(block != NULL){
+        Arena_block *previous = block->previous;
+        free(block);
+        block = previous;
+    }
+    free(arena);
+}
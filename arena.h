@@ -0,0 +1,29 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// the first block, every next one is twice as big as the previous
+#define ARENA_FIRST_BLOCK_SIZE 65536
+
+typedef struct arena_block {
+    struct arena_block *previous;
+    size_t size;
+    size_t used;
+    char data[];
+} Arena_block;
+
+// bump allocator for memory that lives until the end of a compilation
+typedef struct arena {
+    Arena_block *current;
+    void *last_allocation;
+    size_t allocated;
+} Arena;
+
+Arena *arena_create();
+void *arena_alloc(Arena *arena, size_t size);
+void *arena_grow(Arena *arena, void *ptr, size_t old_size, size_t new_size);
+char *arena_strndup(Arena *arena, const char *str, size_t length);
+void arena_destroy(Arena *arena);
+
+#endif
@@ -0,0 +1,110 @@
+#include "env.h"
+#include "token.h"
+
+Scope_env *init_scope_env(Arena *arena){
+    Scope_env *env = arena_alloc(arena, sizeof(Scope_env));
+    if(env == NULL){
+        return NULL;
+    }
+
+    env->arena = arena;
+    env->atom_capacity = 0;
+    env->innermost = NULL;
+
+    env->binding_count = 0;
+    env->binding_capacity = 64;
+    env->bindings = arena_alloc(arena, sizeof(Binding) * env->binding_capacity);
+
+    env->depth = 0;
+    env->mark_capacity = 16;
+    env->marks = arena_alloc(arena, sizeof(int) * env->mark_capacity);
+    if(env->bindings == NULL || env->marks == NULL){
+        return NULL;
+    }
+
+    return env;
+}
+
+// a block is opened, returns 0 if out of memory
+int enter_scope(Scope_env *env){
+    if(env->depth == env->mark_capacity){
+        int *marks = arena_grow(env->arena, env->marks,
+            sizeof(int) * env->mark_capacity, sizeof(int) * env->mark_capacity * 2);
+        if(marks == NULL){
+            return 0;
+        }
+        env->marks = marks;
+        env->mark_capacity *= 2;
+    }
+
+    env->marks[env->depth++] = env->binding_count;
+    return 1;
+}
+
+// atoms are handed out while the parser runs, the table follows them
+static int reserve_atom(Scope_env *env, int atom){
+    if(atom < env->atom_capacity){
+        return 1;
+    }
+
+    int new_capacity = env->atom_capacity ? env->atom_capacity * 2 : 256;
+    while(atom >= new_capacity){
+        new_capacity *= 2;
+    }
+    int *innermost = arena_grow(env->arena, env->innermost,
+        sizeof(int) * env->atom_capacity, sizeof(int) * new_capacity);
+    if(innermost == NULL){
+        return 0;
+    }
+    for(int i = env->atom_capacity; i < new_capacity; i++){
+        innermost[i] = -1;
+    }
+
+    env->innermost = innermost;
+    env->atom_capacity = new_capacity;
+    return 1;
+}
+
+// the name is declared in the innermost open block, returns 0 if out of memory
+int declare(Scope_env *env, int atom, int scope){
+    if(!reserve_atom(env, atom)){
+        return 0;
+    }
+    if(env->binding_count == env->binding_capacity){
+        Binding *bindings = arena_grow(env->arena, env->bindings,
+            sizeof(Binding) * env->binding_capacity, sizeof(Binding) * env->binding_capacity * 2);
+        if(bindings == NULL){
+            return 0;
+        }
+        env->bindings = bindings;
+        env->binding_capacity *= 2;
+    }
+
+    Binding *binding = &env->bindings[env->binding_count];
+    binding->atom = atom;
+    binding->scope = scope;
+    binding->shadowed = env->innermost[atom];
+    env->innermost[atom] = env->binding_count++;
+    return 1;
+}
+
+// scope of the innermost declaration of the name, BINDING_NONE if no open block declares it
+int resolve(Scope_env *env, int atom){
+    if(atom < 0 || atom >= env->atom_capacity || env->innermost[atom] < 0){
+        return BINDING_NONE;
+    }
+    return env->bindings[env->innermost[atom]].scope;
+}
+
+// the innermost block is closed, the names it declared uncover what they hid
+void exit_scope(Scope_env *env){
+    if(env->depth == 0){
+        return;
+    }
+
+    int mark = env->marks[--env->depth];
+    while(env->binding_count > mark){
+        Binding *binding = &env->bindings[--env->binding_count];
+        env->innermost[binding->atom] = binding->shadowed;
+    }
+}
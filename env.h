@@ -0,0 +1,36 @@
+#ifndef ENV_H
+#define ENV_H
+
+#include "arena.h"
+
+// a var declaration visible from where the parser is
+typedef struct binding {
+    int atom;
+    int scope;      // the block the var was declared in
+    int shadowed;   // binding of the same name it hides, -1 if there's none
+} Binding;
+
+// the declarations of the blocks that are open right now, every name keeps
+// a chain of its bindings with the innermost one first, so a name resolves in one step
+typedef struct scope_env {
+    Arena *arena;
+
+    int *innermost;     // atom -> its innermost binding, -1 if there's none
+    int atom_capacity;
+
+    Binding *bindings;  // stack, the bindings of the innermost block on top
+    int binding_count;
+    int binding_capacity;
+
+    int *marks;         // binding_count when each open block was entered
+    int depth;
+    int mark_capacity;
+} Scope_env;
+
+Scope_env *init_scope_env(Arena *arena);
+int enter_scope(Scope_env *env);
+int declare(Scope_env *env, int atom, int scope);
+int resolve(Scope_env *env, int atom);
+void exit_scope(Scope_env *env);
+
+#endif
@@ -0,0 +1,129 @@
+#include <string.h>
+#include "frozen.h"
+
+// the arrays are never empty, so a NULL always means the arena ran out
+static void *alloc_ints(Arena *arena, int count){
+    return arena_alloc(arena, sizeof(int) * (count > 0 ? count : 1));
+}
+
+// builds the snapshot in the symtable's arena, the symtable itself is left as it is
+// returns NULL if the system runs out of memory
+const Frozen_symtable *symtable_freeze(Symtable *symtable){
+    Arena *arena = symtable->arena;
+    Frozen_symtable *frozen = arena_alloc(arena, sizeof(Frozen_symtable));
+    if(frozen == NULL){
+        return NULL;
+    }
+
+    int name_count = symtable->names->count;
+    int entries = symtable->number_of_entries;
+    int *name_start = alloc_ints(arena, name_count + 1);
+    int *next = alloc_ints(arena, name_count);
+    int *record_of = alloc_ints(arena, entries);    // insertion index -> record
+    Symbol *records = arena_alloc(arena, sizeof(Symbol) * (entries > 0 ? entries : 1));
+    if(name_start == NULL || next == NULL || record_of == NULL || records == NULL){
+        return NULL;
+    }
+
+    // counting sort by atom, it keeps the symbols of a name in the order they were inserted
+    memset(name_start, 0, sizeof(int) * (name_count + 1));
+    for(int i = 0; i < entries; i++){
+        int atom = symtable->symbols[i]->sym_atom;
+        if(atom != ATOM_NONE){
+            name_start[atom + 1]++;
+        }
+    }
+    for(int atom = 0; atom < name_count; atom++){
+        name_start[atom + 1] += name_start[atom];
+        next[atom] = name_start[atom];
+    }
+
+    int record_count = 0;
+    for(int i = 0; i < entries; i++){
+        Symbol *symbol = symtable->symbols[i];
+        record_of[i] = -1;
+        if(symbol->sym_atom != ATOM_NONE){
+            record_of[i] = next[symbol->sym_atom]++;
+            records[record_of[i]] = *symbol;
+            record_count++;
+        }
+    }
+
+    for(int type = 0; type < IDENTIF_T_UNSET; type++){
+        int *by_kind = alloc_ints(arena, name_count);
+        int *kind_list = alloc_ints(arena, name_count);
+        if(by_kind == NULL || kind_list == NULL){
+            return NULL;
+        }
+        for(int atom = 0; atom < name_count; atom++){
+            by_kind[atom] = -1;
+        }
+
+        int count = 0;
+        for(int i = 0; i < entries; i++){
+            Symbol *symbol = symtable->symbols[i];
+            int atom = symbol->sym_atom;
+            if(record_of[i] >= 0 && atom < symtable->by_kind_capacity && symtable->by_kind[type][atom] == symbol){
+                by_kind[atom] = record_of[i];
+                kind_list[count++] = record_of[i];
+            }
+        }
+
+        frozen->by_kind[type] = by_kind;
+        frozen->kind_list[type] = kind_list;
+        frozen->kind_count[type] = count;
+    }
+
+    frozen->scopes = symtable->scopes;
+    frozen->names = symtable->names;
+    frozen->literals = symtable->literals;
+    frozen->name_start = name_start;
+    frozen->name_count = name_count;
+    frozen->records = records;
+    frozen->record_count = record_count;
+    return frozen;
+}
+
+// tokens the lexer didn't register (made up later on) are looked up by their spelling
+int frozen_token_atom(const Frozen_symtable *frozen, const Token *token){
+    if(token->atom != ATOM_NONE || token->token_lexeme == NULL){
+        return token->atom;
+    }
+    return intern_find(frozen->names, token->token_lexeme, strlen(token->token_lexeme));
+}
+
+static const Symbol *named_records(const Frozen_symtable *frozen, int atom, int *count){
+    if(atom < 0 || atom >= frozen->name_count){
+        *count = 0;
+        return NULL;
+    }
+    *count = frozen->name_start[atom + 1] - frozen->name_start[atom];
+    return *count > 0 ? &frozen->records[frozen->name_start[atom]] : NULL;
+}
+
+// the records with the name of the atom, oldest first, NULL and a count of 0 if there's none
+const Symbol *frozen_named(const Frozen_symtable *frozen, int atom, int *count){
+    SYMTABLE_STAT_SHARED(frozen_named);
+    return named_records(frozen, atom, count);
+}
+
+// same as search_table
+const Symbol *frozen_search(const Frozen_symtable *frozen, const Token *token){
+    SYMTABLE_STAT_SHARED(frozen_search);
+    // the token's own scope has to be on its chain, which never holds for the root
+    if(!scope_chain_contains(frozen->scopes, token->scope, token->scope)){
+        return NULL;
+    }
+
+    int count;
+    return named_records(frozen, frozen_token_atom(frozen, token), &count);
+}
+
+// the oldest record of the kind with the name
+const Symbol *frozen_find_kind(const Frozen_symtable *frozen, IDENTIF_TYPE type, int atom){
+    SYMTABLE_STAT_SHARED(frozen_find_kind);
+    if(atom < 0 || atom >= frozen->name_count || type == IDENTIF_T_UNSET || frozen->by_kind[type][atom] < 0){
+        return NULL;
+    }
+    return &frozen->records[frozen->by_kind[type][atom]];
+}
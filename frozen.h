@@ -0,0 +1,34 @@
+#ifndef FROZEN_H
+#define FROZEN_H
+
+#include "symtable.h"
+
+// read-only copy of the symtable, made once the semantic pass is done,
+// nothing in it changes afterwards, so any number of threads can query it at once
+typedef struct frozen_symtable {
+    const Scope_tree *scopes;
+    const Intern_table *names;
+    const Literal_table *literals;  // the lexer decodes every literal, the snapshot only reads them
+
+    // atoms are numbered densely from 0, so the atom of a name is its perfect hash,
+    // the records of an atom go from name_start[atom] up to name_start[atom + 1]
+    const int *name_start;
+    int name_count;
+    const Symbol *records;      // grouped by name, in the order they were inserted
+    int record_count;
+
+    // the oldest record of each kind by name, -1 if there's none,
+    // IDENTIF_T_VARIABLE holds just the global variables
+    const int *by_kind[IDENTIF_T_UNSET];
+    // the records of by_kind, in the order they were inserted
+    const int *kind_list[IDENTIF_T_UNSET];
+    int kind_count[IDENTIF_T_UNSET];
+} Frozen_symtable;
+
+const Frozen_symtable *symtable_freeze(Symtable *symtable);
+int frozen_token_atom(const Frozen_symtable *frozen, const Token *token);
+const Symbol *frozen_named(const Frozen_symtable *frozen, int atom, int *count);
+const Symbol *frozen_search(const Frozen_symtable *frozen, const Token *token);
+const Symbol *frozen_find_kind(const Frozen_symtable *frozen, IDENTIF_TYPE type, int atom);
+
+#endif
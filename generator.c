@@ -1,4 +1,3 @@
-#include <ctype.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -12,7 +11,7 @@
 #include "utils.h"
 
 // Initialize generator
-Generator *init_generator(Symtable *symtable) {
+Generator *init_generator(const Frozen_symtable *symtable) {
   Generator *gen = malloc(sizeof(Generator));
   if (!gen) {
     return NULL;
@@ -65,43 +64,17 @@ char **generate_global_vars(Generator *generator) {
     return NULL;
   }
 
-  Symtable *symtable = generator->symtable;
-  int capacity = 10;
-  int count = 0;
-  char **global_vars = malloc(capacity * sizeof(char *));
+  // the symtable keeps every global variable name once
+  const Frozen_symtable *symtable = generator->symtable;
+  int count = symtable->kind_count[IDENTIF_T_VARIABLE];
+  char **global_vars = malloc((count > 0 ? count : 1) * sizeof(char *));
 
   if (!global_vars) {
     generator->error = ERR_T_MALLOC_ERR;
     return NULL;
   }
-  // handling reapeating global variables, prevents duplicates
-  for (int i = 0; i < symtable->symtable_size; i++) {
-    if (symtable->symtable_rows[i].symbol != NULL) {
-      Symbol *sym = symtable->symtable_rows[i].symbol;
-      if (sym->is_global && sym->sym_identif_type == IDENTIF_T_VARIABLE) {
-        int exists = 0;
-        for (int k = 0; k < count; k++) {
-            if (strcmp(global_vars[k], sym->sym_lexeme) == 0) {
-                exists = 1;
-                break;
-            }
-        }
-        // if the variable is not in the array, add it
-        if (!exists) {
-            if (count >= capacity) {
-              capacity *= 2;
-              char **temp = realloc(global_vars, capacity * sizeof(char *));
-              if (!temp) {
-                free(global_vars);
-                generator->error = ERR_T_MALLOC_ERR;
-                return NULL;
-              }
-              global_vars = temp;
-            }
-            global_vars[count++] = sym->sym_lexeme;
-        }
-      }
-    }
+  for (int i = 0; i < count; i++) {
+    global_vars[i] = symtable->records[symtable->kind_list[IDENTIF_T_VARIABLE][i]].sym_lexeme;
   }
 
   generator->global_count = count;
@@ -164,134 +137,13 @@ void generator_emit(Generator *generator, const char *format, ...) {
   fprintf(out, "\n");
 }
 
-// Convert float to hexadecimal format
-static char *convert_float_to_hex_format(const char *float_str) {
-  if (!float_str)
-    return NULL;
-
-  double value = strtod(float_str, NULL);
-
-  char *hex_str = malloc(64);
-  if (!hex_str)
+// Get the decoded literal, the lexer decodes every number and string it emits
+static const Literal *get_literal(Generator *generator, const Token *token) {
+  if (token->literal == LITERAL_NONE) {
+    generator->error = ERR_T_INTERNAL_ERR;
     return NULL;
-
-  snprintf(hex_str, 64, "%a", value);
-
-  return hex_str;
-}
-
-// Convert string to one with escape sequences
-static char *convert_string(const char *str) {
-  if (!str)
-    return NULL;
-
-  int len = strlen(str);
-  char *result = malloc(len * 4 + 1);
-  if (!result)
-    return NULL;
-
-  int pos = 0;
-  int i = 0;
-
-  while (i < len) {
-    unsigned char c = (unsigned char)str[i];
-
-    if (c == '\\' && i + 1 < len) {
-      char next = str[i + 1];
-      switch (next) {
-      case 'n':
-        result[pos++] = '\\';
-        result[pos++] = '0';
-        result[pos++] = '1';
-        result[pos++] = '0';
-        i += 2;
-        continue;
-      case 't':
-        result[pos++] = '\\';
-        result[pos++] = '0';
-        result[pos++] = '0';
-        result[pos++] = '9';
-        i += 2;
-        continue;
-      case 'r':
-        result[pos++] = '\\';
-        result[pos++] = '0';
-        result[pos++] = '1';
-        result[pos++] = '3';
-        i += 2;
-        continue;
-      case '\\':
-        result[pos++] = '\\';
-        result[pos++] = '0';
-        result[pos++] = '9';
-        result[pos++] = '2';
-        i += 2;
-        continue;
-      case '"':
-        result[pos++] = '\\';
-        result[pos++] = '0';
-        result[pos++] = '3';
-        result[pos++] = '4';
-        i += 2;
-        continue;
-      case 'x':
-        if (i + 3 < len && isxdigit(str[i + 2]) && isxdigit(str[i + 3])) {
-          result[pos++] = '\\';
-          result[pos++] = 'x';
-          result[pos++] = str[i + 2];
-          result[pos++] = str[i + 3];
-          i += 4;
-          continue;
-        }
-        break;
-      }
-    }
-
-    if (c == ' ') {
-      result[pos++] = '\\';
-      result[pos++] = '0';
-      result[pos++] = '3';
-      result[pos++] = '2';
-    } else if (c == '\n') {
-      result[pos++] = '\\';
-      result[pos++] = '0';
-      result[pos++] = '1';
-      result[pos++] = '0';
-    } else if (c == '#') {
-      result[pos++] = '\\';
-      result[pos++] = '0';
-      result[pos++] = '3';
-      result[pos++] = '5';
-    } else if (c == '\\') {
-      result[pos++] = '\\';
-      result[pos++] = '0';
-      result[pos++] = '9';
-      result[pos++] = '2';
-    } else if (c < 32 || c > 126) {
-      result[pos++] = '\\';
-      int ascii = (int)c;
-      if (ascii < 10) {
-        result[pos++] = '0';
-        result[pos++] = '0';
-        result[pos++] = '0' + ascii;
-      } else if (ascii < 100) {
-        result[pos++] = '0';
-        result[pos++] = '0' + (ascii / 10);
-        result[pos++] = '0' + (ascii % 10);
-      } else {
-        result[pos++] = '0' + (ascii / 100);
-        result[pos++] = '0' + ((ascii / 10) % 10);
-        result[pos++] = '0' + (ascii % 10);
-      }
-    } else {
-      result[pos++] = c;
-    }
-
-    i++;
   }
-
-  result[pos] = '\0';
-  return result;
+  return literal_get(generator->symtable->literals, token->literal);
 }
 
 // Get instruction for operator
@@ -321,37 +173,6 @@ const char *get_operator_instruction(const char *operator) {
   return NULL;
 }
 
-// Search for getter/setter with prefix
-static Symbol *search_prefixed_symbol(Symtable *symtable, const char *base_name, const char *prefix, IDENTIF_TYPE target_type) {
-  if (!symtable || !base_name || !prefix) {
-    return NULL;
-  }
-
-  size_t prefix_len = strlen(prefix);
-  size_t base_len = strlen(base_name);
-  char *prefixed_name = malloc(prefix_len + base_len + 1);
-  if (!prefixed_name) {
-    return NULL;
-  }
-  sprintf(prefixed_name, "%s%s", prefix, base_name);
-
-  Symbol *result = NULL;
-  for (int i = 0; i < symtable->symtable_size; i++) {
-    Symbol *sym = symtable->symtable_rows[i].symbol;
-    if (!sym || !sym->sym_lexeme) continue;
-
-    if (strcmp(sym->sym_lexeme, prefixed_name) == 0) {
-      if (sym->sym_identif_type == target_type) {
-        result = sym;
-        break;
-      }
-    }
-  }
-
-  free(prefixed_name);
-  return result;
-}
-
 // Generate strcmp comparison
 void generate_strcmp_comparison(Generator *generator, tree_node_t *node) {
   if (!generator || !node)
@@ -419,38 +240,19 @@ void generate_strcmp_comparison(Generator *generator, tree_node_t *node) {
 }
 
 
-// Get scope suffix for local variable for correct declaration in various code blocks
-static int get_scope_suffix(Generator *generator, Token *token) {
-  if (!token) return generator->current_scope;
-  
-  // Collect all symbols with matching name
-  Symbol *candidates[32];
-  int candidate_count = 0;
-  for (int i = 0; i < generator->symtable->symtable_size && candidate_count < 32; i++) {
-      Symbol *s = generator->symtable->symtable_rows[i].symbol;
-      if (!s || !s->sym_lexeme) continue;
-      // can not be global or parameter
-      if (strcmp(s->sym_lexeme, token->token_lexeme) == 0 && 
-          s->sym_identif_type == IDENTIF_T_VARIABLE && !s->is_global && !s->is_parameter) {
-          candidates[candidate_count++] = s;
-      }
-  }
-  
-  if (candidate_count == 0) {
-    return generator->current_scope; // if no candidates, return current scope
-  }
-
+// scope of the declaration a token the parser didn't resolve refers to, -1 if there's none
+static int find_outer_declaration(Generator *generator, const Symbol **candidates, int candidate_count, Token *token) {
   int token_scope = token->scope;
   int token_line = token->token_line_number;
   
   // Check if declared in current scope BEFORE the token
   // this ensures variables are declared before they are used
   for (int c = 0; c < candidate_count; c++) {
-      Symbol *s = candidates[c];
-      if (!s->sym_identif_declaration_count) continue;
-      for (int i = 0; i < s->sym_identif_declaration_count; i++) {
-          if (s->sym_identif_declared_at_scope_arr[i] == token_scope) {
-              int decl_line = s->sym_identif_declared_at_line_arr[i];
+      const Symbol *s = candidates[c];
+      if (!s->cold->sym_identif_declaration_count) continue;
+      for (int i = 0; i < s->cold->sym_identif_declaration_count; i++) {
+          if (s->cold->sym_identif_declared_at_scope_arr[i] == token_scope) {
+              int decl_line = s->cold->sym_identif_declared_at_line_arr[i];
               if (decl_line < token_line) {
                   // Found declaration in current scope before usage - use it
                   return token_scope;
@@ -460,40 +262,20 @@ static int get_scope_suffix(Generator *generator, Token *token) {
   }
   
   // Not declared in current scope before usage - find declaration in outer scopes
-  // Build list of parent (outer) scopes
-  int parent_scopes[64];
-  int parent_count = 0;
-  
-  if (token->previous_scope_arr && token->scope_count > 0) {
-      for (int j = 0; j < token->scope_count; j++) {
-          parent_scopes[parent_count++] = token->previous_scope_arr[j];
-      }
-  }
-  
-  // Also check generator->current_scope if it's different and might be a parent
-  if (generator->current_scope != token_scope) {
-      // Check if it's already in parent_scopes
-      bool found = false;
-      for (int j = 0; j < parent_count; j++) {
-          if (parent_scopes[j] == generator->current_scope) {
-              found = true;
-              break;
-          }
-      }
-      if (!found) {
-          parent_scopes[parent_count++] = generator->current_scope;
-      }
-  }
+  // Parent (outer) scopes are the token's scope chain, plus generator->current_scope
+  // if it's different and might be a parent
+  const Scope_tree *scopes = generator->symtable->scopes;
+  bool check_current_scope = generator->current_scope != token_scope;
   
   // Find the highest scope number among parent scopes that has a declaration
   int best_parent_scope = -1; // best parent scope is the highest scope number among parent scopes that has a declaration
   for (int c = 0; c < candidate_count; c++) {
-      Symbol *s = candidates[c];
-      if (!s->sym_identif_declaration_count) continue;
+      const Symbol *s = candidates[c];
+      if (!s->cold->sym_identif_declaration_count) continue;
       
-      for (int i = 0; i < s->sym_identif_declaration_count; i++) {
-          int decl_scope = s->sym_identif_declared_at_scope_arr[i];
-          int decl_line = s->sym_identif_declared_at_line_arr[i];
+      for (int i = 0; i < s->cold->sym_identif_declaration_count; i++) {
+          int decl_scope = s->cold->sym_identif_declared_at_scope_arr[i];
+          int decl_line = s->cold->sym_identif_declared_at_line_arr[i];
           
           // Skip declarations that occur AFTER the usage line
           if (decl_line >= token_line) {
@@ -501,26 +283,57 @@ static int get_scope_suffix(Generator *generator, Token *token) {
           }
           
           // Check if this declaration scope is in parent scopes
-          for (int p = 0; p < parent_count; p++) {
-              if (parent_scopes[p] == decl_scope) {
-                  // Found declaration in a parent scope BEFORE usage
-                  // Prefer the highest scope number (most recent/closest parent)
-                  if (best_parent_scope < 0 || decl_scope > best_parent_scope) {
-                      best_parent_scope = decl_scope;
-                  }
+          if (scope_chain_contains(scopes, token_scope, decl_scope) ||
+              (check_current_scope && decl_scope == generator->current_scope)) {
+              // Found declaration in a parent scope BEFORE usage
+              // Prefer the highest scope number (most recent/closest parent)
+              if (best_parent_scope < 0 || decl_scope > best_parent_scope) {
+                  best_parent_scope = decl_scope;
               }
           }
       }
   }
   
-  if (best_parent_scope >= 0) {
-      return best_parent_scope;
+  return best_parent_scope;
+}
+
+// Get scope suffix for local variable for correct declaration in various code blocks
+static int get_scope_suffix(Generator *generator, Token *token) {
+  if (!token) return generator->current_scope;
+  
+  // Collect all symbols with matching name
+  int atom = frozen_token_atom(generator->symtable, token);
+  const Symbol *candidates[32];
+  int candidate_count = 0;
+  int named_count;
+  const Symbol *named = frozen_named(generator->symtable, atom, &named_count);
+  for (int i = 0; i < named_count && candidate_count < 32; i++) {
+      const Symbol *s = &named[i];
+      // can not be global or parameter
+      if (s->sym_identif_type == IDENTIF_T_VARIABLE && !s->is_global && !s->is_parameter) {
+          candidates[candidate_count++] = s;
+      }
+  }
+  
+  if (candidate_count == 0) {
+    return generator->current_scope; // if no candidates, return current scope
+  }
+
+  // the parser resolved the name while its blocks were open
+  if (token->binding_scope >= 0) {
+    return token->binding_scope;
+  }
+  if (token->binding_scope == BINDING_UNRESOLVED) {
+    int outer_scope = find_outer_declaration(generator, candidates, candidate_count, token);
+    if (outer_scope >= 0) {
+      return outer_scope;
+    }
   }
   
   // Fallback: return the most recent declaration from first candidate
-  Symbol *sym = candidates[0];
-  if (sym && sym->sym_identif_declaration_count > 0) {
-      return sym->sym_identif_declared_at_scope_arr[sym->sym_identif_declaration_count - 1];
+  const Symbol *sym = candidates[0];
+  if (sym && sym->cold->sym_identif_declaration_count > 0) {
+      return sym->cold->sym_identif_declared_at_scope_arr[sym->cold->sym_identif_declaration_count - 1];
   }
   
   // if nothing found, return current scope
@@ -528,14 +341,15 @@ static int get_scope_suffix(Generator *generator, Token *token) {
 }
 
 // Check if variable is function parameter
-static bool is_function_parameter(Generator *generator, const char *var_name) {
-  if (!generator->in_function || !var_name || !generator->function_params) {
+static bool is_function_parameter(Generator *generator, Token *token) {
+  if (!generator->in_function || !token || !generator->function_params) {
     return false;
   }
   
   // Check stored parameter names
+  int atom = frozen_token_atom(generator->symtable, token);
   for (int i = 0; i < generator->function_param_count; i++) {
-    if (generator->function_params[i] && strcmp(generator->function_params[i], var_name) == 0) {
+    if (generator->function_params[i] == atom) {
       return true;
     }
   }
@@ -550,7 +364,7 @@ static void format_local_var(Generator *generator, Token *token, char *buffer, s
     return;
   }
   
-  if (generator->in_function && is_function_parameter(generator, token->token_lexeme)) {
+  if (generator->in_function && is_function_parameter(generator, token)) {
     snprintf(buffer, buffer_size, "LF@%s", token->token_lexeme);
     return;
   }
@@ -569,50 +383,19 @@ void generate_terminal(Generator *generator, tree_node_t *node) {
 
   switch (token->token_type) {
   case TOKEN_T_NUM: { // a case with number
-    char *hex_str = convert_float_to_hex_format(token->token_lexeme);
-    if (hex_str) {
+    // the operand text is built once per distinct literal by the lexer
+    const Literal *literal = get_literal(generator, token);
+    if (literal) {
       generator->is_float = true;
-      generator_emit(generator, "PUSHS float@%s", hex_str);
-      free(hex_str);
-    } else {
-      generator->error = ERR_T_MALLOC_ERR;
+      generator_emit(generator, "PUSHS %s", literal->ifjcode);
     }
     break;
   }
   case TOKEN_T_STRING: { // a case with string
-    char *str_value = token->token_lexeme;
-    char *clean_str = NULL;
-
-    // remove quotes at the beginning and end
-    if (str_value[0] == '"' && str_value[strlen(str_value) - 1] == '"') {
-      int len = strlen(str_value) - 2;
-      clean_str = malloc(len + 1);
-      if (clean_str) {
-        strncpy(clean_str, str_value + 1, len);
-        clean_str[len] = '\0';
-      }
-    } else {
-      // copy of the original string
-      clean_str = malloc(strlen(str_value) + 1);
-      if (clean_str) {
-        strcpy(clean_str, str_value);
-      }
-    }
-
-    if (clean_str) {
-      // convert to string with escape sequences
-      char *converted = convert_string(clean_str);
-      if (converted) {
-        generator_emit(generator, "PUSHS string@%s", converted);
-        free(converted);
-      } else {
-        generator->error = ERR_T_MALLOC_ERR;
-        generator_emit(generator, "PUSHS string@%s", clean_str);
-      }
-      free(clean_str);
-    } else {
-      generator->error = ERR_T_MALLOC_ERR;
-      generator_emit(generator, "PUSHS string@%s", str_value);
+    // quotes and escapes are already dealt with, one encoding per distinct literal
+    const Literal *literal = get_literal(generator, token);
+    if (literal) {
+      generator_emit(generator, "PUSHS %s", literal->ifjcode);
     }
     break;
   }
@@ -628,11 +411,11 @@ void generate_terminal(Generator *generator, tree_node_t *node) {
   }
   case TOKEN_T_IDENTIFIER: // a case with either identifier or global variable
   case TOKEN_T_GLOBAL_VAR: {
-    Symbol *sym = search_table(token, generator->symtable);
+    const Symbol *sym = frozen_search(generator->symtable, token);
     
     // always try to find getter
     int is_getter = 0;
-    Symbol *getter_sym = search_prefixed_symbol(generator->symtable, token->token_lexeme, "getter+", IDENTIF_T_GETTER);
+    const Symbol *getter_sym = frozen_find_kind(generator->symtable, IDENTIF_T_GETTER, frozen_token_atom(generator->symtable, token));
     if (getter_sym) {
         sym = getter_sym;
         is_getter = 1;
@@ -730,7 +513,7 @@ static bool is_string_type(Generator *generator, tree_node_t *node) {
     if (node->token) {
       if (node->token->token_type == TOKEN_T_STRING) return true;
       if (node->token->token_type == TOKEN_T_IDENTIFIER || node->token->token_type == TOKEN_T_GLOBAL_VAR) {
-        Symbol *sym = search_table(node->token, generator->symtable);
+        const Symbol *sym = frozen_search(generator->symtable, node->token);
         if (sym) {
           if (sym->sym_variable_type == VAR_T_STRING) return true;
         }
@@ -756,9 +539,9 @@ static bool is_string_type(Generator *generator, tree_node_t *node) {
   // Function calls that return strings
   if (node->nonterm_type == NONTERMINAL_T_FUN_CALL || node->nonterm_type == NONTERMINAL_T_EXPRESSION_OR_FN) {
     if (node->children_count > 0 && node->children[0]->token) {
-      char *name = node->children[0]->token->token_lexeme;
-      if (strcmp(name, "read_str") == 0 || strcmp(name, "str") == 0 || 
-          strcmp(name, "substring") == 0 || strcmp(name, "chr") == 0) {
+      int atom = node->children[0]->token->atom;
+      if (atom == ATOM_READ_STR || atom == ATOM_STR || 
+          atom == ATOM_SUBSTRING || atom == ATOM_CHR) {
         return true;
       }
     }
@@ -775,7 +558,7 @@ static bool is_number_type(Generator *generator, tree_node_t *node) {
     if (node->token) {
       if (node->token->token_type == TOKEN_T_NUM) return true;
       if (node->token->token_type == TOKEN_T_IDENTIFIER || node->token->token_type == TOKEN_T_GLOBAL_VAR) {
-        Symbol *sym = search_table(node->token, generator->symtable);
+        const Symbol *sym = frozen_search(generator->symtable, node->token);
         if (sym && sym->sym_variable_type == VAR_T_NUM) return true;
       }
     }
@@ -797,9 +580,9 @@ static bool is_number_type(Generator *generator, tree_node_t *node) {
   // Function calls that return numbers
   if (node->nonterm_type == NONTERMINAL_T_FUN_CALL || node->nonterm_type == NONTERMINAL_T_EXPRESSION_OR_FN) {
     if (node->children_count > 0 && node->children[0]->token) {
-      char *name = node->children[0]->token->token_lexeme;
-      if (strcmp(name, "read_num") == 0 || strcmp(name, "floor") == 0 || 
-          strcmp(name, "length") == 0 || strcmp(name, "ord") == 0) {
+      int atom = node->children[0]->token->atom;
+      if (atom == ATOM_READ_NUM || atom == ATOM_FLOOR || 
+          atom == ATOM_LENGTH || atom == ATOM_ORD) {
         return true;
       }
     }
@@ -838,42 +621,17 @@ static char *get_operand_for_concat(Generator *generator, tree_node_t *node) {
   if (node->type == NODE_T_TERMINAL) {
     Token *token = node->token;
     if (token->token_type == TOKEN_T_STRING) {
-      char *str_value = token->token_lexeme;
-      char *clean_str = NULL;
-      // remove quotes at the beginning and end
-      if (str_value[0] == '"' && str_value[strlen(str_value) - 1] == '"') {
-        int len = strlen(str_value) - 2;
-        clean_str = malloc(len + 1);
-        if (clean_str) {
-          strncpy(clean_str, str_value + 1, len);
-          clean_str[len] = '\0';
-        }
-      } else {
-        clean_str = malloc(strlen(str_value) + 1);
-        if (clean_str) strcpy(clean_str, str_value);
-      }
-      // convert to string with escape sequences
-      char *converted = convert_string(clean_str);
-      free(clean_str);
-      
-      if (!converted) {
-        return NULL;
-      }
-      // allocate memory for the result
-      char *result = malloc(strlen(converted) + 10);
-      if (!result) {
-        free(converted);
+      const Literal *literal = get_literal(generator, token);
+      if (!literal) {
         return NULL;
       }
-      // format the result
-      sprintf(result, "string@%s", converted);
-      free(converted);
-      return result;
+      // the caller frees the operand
+      return strdup(literal->ifjcode);
     } else if (token->token_type == TOKEN_T_IDENTIFIER || token->token_type == TOKEN_T_GLOBAL_VAR) {
-       Symbol *sym = search_table(token, generator->symtable);
+       const Symbol *sym = frozen_search(generator->symtable, token);
        
        bool is_getter = false; // flag to check if the symbol is a getter
-       Symbol *getter_sym = search_prefixed_symbol(generator->symtable, token->token_lexeme, "getter+", IDENTIF_T_GETTER);
+       const Symbol *getter_sym = frozen_find_kind(generator->symtable, IDENTIF_T_GETTER, frozen_token_atom(generator->symtable, token));
        if (getter_sym) {
          is_getter = true;
        } else if (sym && sym->sym_identif_type == IDENTIF_T_GETTER) {
@@ -1257,9 +1015,9 @@ void generate_assignment(Generator *generator, tree_node_t *node) {
   }
 
   if (expr_node) {
-    Symbol *sym = search_table(id_token, generator->symtable);
+    const Symbol *sym = frozen_search(generator->symtable, id_token);
     
-    Symbol *setter_sym = search_prefixed_symbol(generator->symtable, id_token->token_lexeme, "setter+", IDENTIF_T_SETTER);
+    const Symbol *setter_sym = frozen_find_kind(generator->symtable, IDENTIF_T_SETTER, frozen_token_atom(generator->symtable, id_token));
 
     // save old value (if exists)
     bool old_is_global = generator->is_global;
@@ -1308,7 +1066,7 @@ void generate_declaration(Generator *generator, tree_node_t *node) {
       if (id_node && id_node->token) {
         Token *id_token = id_node->token;
 
-        Symbol *sym = search_table(id_token, generator->symtable);
+        const Symbol *sym = frozen_search(generator->symtable, id_token);
 
         if (sym && sym->is_global) {
         } else if (!generator->in_while_loop) {
@@ -1339,6 +1097,17 @@ void generate_declaration(Generator *generator, tree_node_t *node) {
   }
 }
 
+// number of params of a declaration or arguments of a call,
+// they're all children of the one GR_FUN_PARAM node, which is missing for ()
+static int function_arity(tree_node_t *node) {
+  for (int i = 0; i < node->children_count; i++) {
+    if (node->children[i]->rule == GR_FUN_PARAM) {
+      return node->children[i]->children_count;
+    }
+  }
+  return 0;
+}
+
 // Generate function declaration
 void generate_function_declaration(Generator *generator, tree_node_t *node) {
   if (!node)
@@ -1373,47 +1142,26 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
   // Clear parameter list at the start of each function
   // (will be used if function has parameters)
   if (generator->function_params) {
-      for (int i = 0; i < generator->function_param_count; i++) {
-          if (generator->function_params[i]) {
-              free(generator->function_params[i]);
-          }
-      }
       free(generator->function_params);
       generator->function_params = NULL;
       generator->function_param_count = 0;
   }
 
-  Symbol *sym = search_table(func_name_node->token, generator->symtable);
+  const Symbol *sym = frozen_search(generator->symtable, func_name_node->token);
 
   int type = diverse_function(generator, node);
   
-  // Strip prefix for label generation if needed
-  char *label_name = func_name;
-  if (strncmp(func_name, "getter+", 7) == 0) {
-      label_name = func_name + 7;
-  } else if (strncmp(func_name, "setter+", 7) == 0) {
-      label_name = func_name + 7;
-  }
-
   // generate label for the getter
   if (type == 1) {
-    generator_emit(generator, "LABEL %s_", label_name);
+    generator_emit(generator, "LABEL %s_", func_name);
 
   } else if (type == 2) {
     // generate label for the setter
-    generator_emit(generator, "LABEL %s__", label_name);
+    generator_emit(generator, "LABEL %s__", func_name);
   } else {
-    if (sym && sym->sym_identif_declaration_count > 1) {
-        // find overload index
-        int overload_index = 0;
-        if (func_name_node && func_name_node->token) {
-            for (int i = 0; i < sym->sym_identif_declaration_count; i++) {
-                if (sym->sym_identif_declared_at_line_arr[i] == func_name_node->token->token_line_number) {
-                    overload_index = i;
-                    break;
-                }
-            }
-        }
+    if (sym && sym->cold->sym_identif_declaration_count > 1) {
+        // the semantic pass rejects two overloads with the same arity
+        int overload_index = symbol_overload_index(sym, function_arity(node));
         generator_emit(generator, "LABEL %s$%d", func_name, overload_index); // generate label for the function with overload index
     } else {
         generator_emit(generator, "LABEL %s", func_name); // generate label for the function
@@ -1424,7 +1172,7 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
   generator_emit(generator, "CREATEFRAME");
   generator_emit(generator, "PUSHFRAME");
   generator->tf_created = false;
-  if(strcmp(func_name, "main") == 0){
+  if(func_name_node->token->atom == ATOM_MAIN){
     for(int i = 0; i < generator->global_count; i++) {
       generator_emit(generator, "DEFVAR GF@%s", generator->global_vars[i]);
       generator_emit(generator, "PUSHS nil@nil");
@@ -1433,9 +1181,9 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
     }
   }
 
-  Symbol *func_sym = NULL;
+  const Symbol *func_sym = NULL;
   if (func_name_node && func_name_node->token && generator->symtable) {
-    func_sym = search_table(func_name_node->token, generator->symtable);
+    func_sym = frozen_search(generator->symtable, func_name_node->token);
   }
 
   if (type == 2) { // setter parameter generation
@@ -1445,17 +1193,10 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
               char *param_name = param_node->token->token_lexeme;
               
               // Store parameter name for later reference checking
-              if (generator->function_params) {
-                  for (int i = 0; i < generator->function_param_count; i++) {
-                      if (generator->function_params[i]) {
-                          free(generator->function_params[i]);
-                      }
-                  }
-                  free(generator->function_params);
-              }
+              free(generator->function_params);
               generator->function_param_count = 1;
-              generator->function_params = malloc(sizeof(char *));
-              generator->function_params[0] = strdup(param_name);
+              generator->function_params = malloc(sizeof(int));
+              generator->function_params[0] = param_node->token->atom;
               
               generator_emit(generator, "DEFVAR LF@%s", param_name);
               generator_emit(generator, "POPS LF@%s", param_name);
@@ -1502,19 +1243,12 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
 
         // Store parameter names for later reference checking
         // Free old parameter list if any
-        if (generator->function_params) {
-            for (int i = 0; i < generator->function_param_count; i++) {
-                if (generator->function_params[i]) {
-                    free(generator->function_params[i]);
-                }
-            }
-            free(generator->function_params);
-        }
+        free(generator->function_params);
         generator->function_param_count = p_count;
         if (p_count > 0) {
-            generator->function_params = malloc(sizeof(char *) * p_count);
+            generator->function_params = malloc(sizeof(int) * p_count);
             for (int i = 0; i < p_count; i++) {
-                generator->function_params[i] = strdup(params[i]->token_lexeme);
+                generator->function_params[i] = params[i]->atom;
             }
         } else {
             generator->function_params = NULL;
@@ -1561,7 +1295,7 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
 
   // pop frame before return
   // Implicit return nil if execution reaches here (only if no explicit return was generated)
-  if (strcmp(generator->current_function, "main") == 0) {
+  if (func_name_node->token->atom == ATOM_MAIN) {
       generator_emit(generator, "POPFRAME");
       generator->tf_created = false;
   } else if (!generator->has_return) {
@@ -1574,11 +1308,6 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
   
   // Free parameter list
   if (generator->function_params) {
-      for (int i = 0; i < generator->function_param_count; i++) {
-          if (generator->function_params[i]) {
-              free(generator->function_params[i]);
-          }
-      }
       free(generator->function_params);
       generator->function_params = NULL;
       generator->function_param_count = 0;
@@ -1591,31 +1320,29 @@ void generate_function_declaration(Generator *generator, tree_node_t *node) {
 }
 
 // Check built-in function parameters
-void check_builtin_params(Generator *generator, char *func_name, tree_node_t *node) {
+void check_builtin_params(Generator *generator, char *func_name, int func_atom, tree_node_t *node) {
     if (!func_name || !node) return;
 
-    char *suffix = func_name + 4; // Skip "Ifj."
-
     // Define expected types
     // 0: string, 1: int, 2: float
     int expected_types[3] = {-1,-1,-1}; 
     int expected_count = 0;
 
-    if (strcmp(suffix, "length") == 0 || strcmp(suffix, "ord") == 0) {
+    if (func_atom == ATOM_LENGTH || func_atom == ATOM_ORD) {
         expected_types[0] = 0; // string
         expected_count = 1;
-    } else if (strcmp(suffix, "chr") == 0) {
+    } else if (func_atom == ATOM_CHR) {
         expected_types[0] = 1; // int
         expected_count = 1;
-    } else if (strcmp(suffix, "floor") == 0) {
+    } else if (func_atom == ATOM_FLOOR) {
         expected_types[0] = 2; // float
         expected_count = 1;
-    } else if (strcmp(suffix, "substring") == 0) {
+    } else if (func_atom == ATOM_SUBSTRING) {
         expected_types[0] = 0; // string
         expected_types[1] = 1; // int
         expected_types[2] = 1; // int
         expected_count = 3;
-    } else if (strcmp(suffix, "strcmp") == 0) {
+    } else if (func_atom == ATOM_STRCMP) {
         expected_types[0] = 0; // string
         expected_types[1] = 0; // string
         expected_count = 2;
@@ -1689,8 +1416,10 @@ void check_builtin_params(Generator *generator, char *func_name, tree_node_t *no
                      return;
                 }
                 if (token_to_check->token_type == TOKEN_T_NUM) {
-                    // Check if it looks like a float
-                    if (strchr(token_to_check->token_lexeme, '.') || strchr(token_to_check->token_lexeme, 'e') || strchr(token_to_check->token_lexeme, 'E')) {
+                    // Check if it's written as a float
+                    const Literal *literal = get_literal(generator, token_to_check);
+                    if (!literal) return;
+                    if (!literal->is_integer) {
                          generator->error = ERR_T_SEMANTIC_ERR_BUILTIN_FN_BAD_PARAM;
                          return;
                     }
@@ -1701,8 +1430,10 @@ void check_builtin_params(Generator *generator, char *func_name, tree_node_t *no
                      return;
                 }
                 if (token_to_check->token_type == TOKEN_T_NUM) {
-                    // Check if it looks like an int (no dot or exponent)
-                    if (!strchr(token_to_check->token_lexeme, '.') && !strchr(token_to_check->token_lexeme, 'e') && !strchr(token_to_check->token_lexeme, 'E')) {
+                    // Check if it's written as an int (no dot or exponent)
+                    const Literal *literal = get_literal(generator, token_to_check);
+                    if (!literal) return;
+                    if (literal->is_integer) {
                          // Strict check: Int passed where float expected
                          generator->error = ERR_T_SEMANTIC_ERR_BUILTIN_FN_BAD_PARAM;
                          return;
@@ -1714,7 +1445,7 @@ void check_builtin_params(Generator *generator, char *func_name, tree_node_t *no
         // Check variable types from symbol table
         if (child->type == NODE_T_TERMINAL && child->token && 
             (child->token->token_type == TOKEN_T_IDENTIFIER || child->token->token_type == TOKEN_T_GLOBAL_VAR)) {
-            Symbol *sym = search_table(child->token, generator->symtable);
+            const Symbol *sym = frozen_search(generator->symtable, child->token);
             if (sym) {
                 if (expected_type == 0) { // Expect string
                     if (sym->sym_variable_type == VAR_T_NUM) { // Assuming VAR_T_NUM covers both int and float
@@ -1764,21 +1495,13 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
     }
   }
 
+  int func_atom = func_name_node ? func_name_node->token->atom : ATOM_NONE;
   if (func_name && has_ifj_prefix) {
     snprintf(full_func_name, sizeof(full_func_name), "Ifj.%s", func_name);
     func_name = full_func_name;
   } else if (func_name) {
     // Check if it's a built-in function without Ifj prefix
-    if (strcmp(func_name, "write") == 0 ||
-        strcmp(func_name, "read_num") == 0 ||
-        strcmp(func_name, "read_str") == 0 ||
-        strcmp(func_name, "length") == 0 ||
-        strcmp(func_name, "floor") == 0 ||
-        strcmp(func_name, "str") == 0 ||
-        strcmp(func_name, "ord") == 0 ||
-        strcmp(func_name, "substring") == 0 ||
-        strcmp(func_name, "strcmp") == 0 ||
-        strcmp(func_name, "chr") == 0) {
+    if (atom_is_builtin_function(func_atom)) {
         snprintf(full_func_name, sizeof(full_func_name), "Ifj.%s", func_name);
         func_name = full_func_name;
     }
@@ -1798,12 +1521,10 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
   // Check for built-in functions
   if (strncmp(func_name, "Ifj.", 4) == 0) {
     
-    check_builtin_params(generator, func_name, node);
+    check_builtin_params(generator, func_name, func_atom, node);
     if (generator->error != 0) return;
 
-    char *suffix = func_name + 4;
-
-    if (strcmp(suffix, "write") == 0) {
+    if (func_atom == ATOM_WRITE) {
       // WRITE - iterate over arguments
       for (int i = 0; i < node->children_count; i++) {
         tree_node_t *child = node->children[i];
@@ -1839,21 +1560,21 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
       }
       generator_emit(generator, "PUSHS nil@nil"); // Return nil
       return;
-    } else if (strcmp(suffix, "read_num") == 0) {
+    } else if (func_atom == ATOM_READ_NUM) {
       char *temp = get_temp_var(generator);
       generator_emit(generator, "DEFVAR %s", temp);
       generator_emit(generator, "READ %s float", temp);
       generator_emit(generator, "PUSHS %s", temp);
       free(temp);
       return;
-    } else if (strcmp(suffix, "read_str") == 0) {
+    } else if (func_atom == ATOM_READ_STR) {
       char *temp = get_temp_var(generator);
       generator_emit(generator, "DEFVAR %s", temp);
       generator_emit(generator, "READ %s string", temp);
       generator_emit(generator, "PUSHS %s", temp);
       free(temp);
       return;
-    } else if (strcmp(suffix, "length") == 0) {
+    } else if (func_atom == ATOM_LENGTH) {
       // STRLEN
       // Expect 1 argument
       for (int i = 0; i < node->children_count; i++) {
@@ -1879,7 +1600,7 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
         }
       }
       return;
-    } else if (strcmp(suffix, "floor") == 0) {
+    } else if (func_atom == ATOM_FLOOR) {
       // FLOAT2INT
       for (int i = 0; i < node->children_count; i++) {
         tree_node_t *child = node->children[i];
@@ -1895,7 +1616,7 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
         }
       }
       return;
-    } else if (strcmp(suffix, "substring") == 0) {
+    } else if (func_atom == ATOM_SUBSTRING) {
       // SUBSTRING
       for (int i = 0; i < node->children_count; i++) {
         tree_node_t *child = node->children[i];
@@ -1985,7 +1706,7 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
 
       free(s); free(p1); free(p2); free(res); free(len); free(cond); free(char_val);
       return;
-    } else if (strcmp(suffix, "str") == 0) {
+    } else if (func_atom == ATOM_STR) {
       for (int i = 0; i < node->children_count; i++) {
         tree_node_t *child = node->children[i];
         if (child == func_name_node)
@@ -2006,11 +1727,11 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
       }
       return;
       // STRCMP
-    } else if (strcmp(suffix, "strcmp") == 0) {
+    } else if (func_atom == ATOM_STRCMP) {
       generate_strcmp_comparison(generator, node);
       return;
       // ORD
-    } else if (strcmp(suffix, "ord") == 0){
+    } else if (func_atom == ATOM_ORD){
       // Expect 2 arguments: string s, int index
       for (int i = 0; i < node->children_count; i++) {
         tree_node_t *child = node->children[i];
@@ -2069,7 +1790,7 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
 
       free(s); free(idx); free(len); free(cond); free(res);
       return;
-    } else if (strcmp(suffix, "chr") == 0) {
+    } else if (func_atom == ATOM_CHR) {
       // Expect 1 argument: int num
       for (int i = 0; i < node->children_count; i++) {
         tree_node_t *child = node->children[i];
@@ -2127,50 +1848,12 @@ void generate_function_call(Generator *generator, tree_node_t *node) {
   generator->is_called = true;
   
   // Search for the function symbol specifically
-  Symbol *sym = NULL;
-  for (int i = 0; i < generator->symtable->symtable_size; i++) {
-      Symbol *s = generator->symtable->symtable_rows[i].symbol;
-      if (s && s->sym_lexeme && strcmp(s->sym_lexeme, func_name) == 0) {
-          if (s->sym_identif_type == IDENTIF_T_FUNCTION) {
-              sym = s;
-              break;
-          }
-      }
-  }
+  // with the Ifj prefix the call never matched a user function
+  const Symbol *sym = has_ifj_prefix ? NULL : frozen_find_kind(generator->symtable, IDENTIF_T_FUNCTION, func_atom);
 
-  if (sym && sym->sym_identif_type == IDENTIF_T_FUNCTION && sym->sym_identif_declaration_count > 1) {
+  if (sym && sym->sym_identif_type == IDENTIF_T_FUNCTION && sym->cold->sym_identif_declaration_count > 1) {
       // Resolve overload based on argument count
-      int arg_count = 0;
-      for (int i = 0; i < node->children_count; i++) {
-        tree_node_t *child = node->children[i];
-        if (child == func_name_node) continue;
-        if (child->type == NODE_T_TERMINAL && child->token) {
-             if (strcmp(child->token->token_lexeme, "(") == 0 ||
-                 strcmp(child->token->token_lexeme, ")") == 0 ||
-                 strcmp(child->token->token_lexeme, "Ifj") == 0) {
-                 continue;
-             }
-        }
-        // Count expressions/params
-        if (child->nonterm_type == NONTERMINAL_T_EXPRESSION ||
-            child->nonterm_type == NONTERMINAL_T_FUN_PARAM ||
-            (child->type == NODE_T_TERMINAL && child->token &&
-             (child->token->token_type == TOKEN_T_NUM ||
-              child->token->token_type == TOKEN_T_STRING ||
-              child->token->token_type == TOKEN_T_IDENTIFIER ||
-              child->token->token_type == TOKEN_T_GLOBAL_VAR))) {
-            arg_count++;
-        }
-      }
-
-      int overload_index = -1;
-      for (int i = 0; i < sym->sym_identif_declaration_count; i++) {
-          if (sym->sym_function_number_of_params[i] == arg_count) {
-              overload_index = i;
-              break;
-          }
-      }
-      
+      int overload_index = symbol_overload_index(sym, function_arity(node));
       if (overload_index != -1) {
           generator_emit(generator, "CALL %s$%d", func_name, overload_index);
       } else {
@@ -2271,7 +1954,7 @@ void generate_if(Generator *generator, tree_node_t *node) {
 }
 
 // collect local variable declarations in subtree
-void collect_local_vars_in_subtree(tree_node_t *node, Token ***tokens, int *count, Symtable *symtable) {
+void collect_local_vars_in_subtree(tree_node_t *node, Token ***tokens, int *count, const Frozen_symtable *symtable) {
   if (!node) return;
 
   // Check if this is a variable declaration
@@ -2286,12 +1969,12 @@ void collect_local_vars_in_subtree(tree_node_t *node, Token ***tokens, int *coun
       }
       
       // check if it's a local variable (not global)
-      Symbol *sym = search_table(id_node->token, symtable);
+      const Symbol *sym = frozen_search(symtable, id_node->token);
       if (sym && !sym->is_global) {
         // check if already in the list
         int found = 0;
         for (int i = 0; i < *count; i++) {
-          if ((*tokens)[i] && strcmp((*tokens)[i]->token_lexeme, var_name) == 0) {
+          if ((*tokens)[i] && (*tokens)[i]->atom == id_node->token->atom) {
             found = 1;
             break;
           }
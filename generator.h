@@ -2,13 +2,13 @@
 #define GENERATOR_H
 
 #include "symbol.h"
-#include "symtable.h"
+#include "frozen.h"
 #include "token.h"
 #include "tree.h"
 #include <stdio.h>
 
 typedef struct generator {
-  Symtable *symtable; // Symbolová tabuľka - na vyhľadávanie premenných/funkcií
+  const Frozen_symtable *symtable; // Symbolová tabuľka - na vyhľadávanie premenných/funkcií
   int label_counter;  // Počítadlo labelov (LABEL_0, LABEL_1, ...)
   int temp_var_counter;   // Počítadlo dočasných premenných
   int current_scope;      // Aktuálny scope
@@ -24,12 +24,12 @@ typedef struct generator {
   bool has_return;  // Flag to track if return statement was generated
   bool tf_created;
   int in_while_loop;  // Flag to track if inside while loop body
-  char **function_params;  // Array of parameter names for current function
+  int *function_params;  // Atoms of the parameter names for current function
   int function_param_count;  // Number of parameters in current function	
 } Generator;
 
 // Inicializácia a základné funkcie
-Generator *init_generator(Symtable *symtable);
+Generator *init_generator(const Frozen_symtable *symtable);
 int generator_start(Generator *generator, tree_node_t *tree);
 void generator_generate(Generator *generator, tree_node_t *node);
 void generator_free(Generator *generator);
@@ -0,0 +1,176 @@
+#include <string.h>
+#include "intern.h"
+
+// spelled in the order of PREDEFINED_ATOM
+static const char *predefined_names[ATOM_PREDEFINED_COUNT] = {
+    "main", "write", "read_str", "read_num", "floor", "str",
+    "length", "substring", "strcmp", "ord", "chr"
+};
+
+static unsigned hash_name(const char *name, int length){
+    unsigned hash = 5381;
+    for(int i = 0; i < length; i++){
+        hash = ((hash << 5) + hash) + (unsigned char)name[i];
+    }
+    return hash;
+}
+
+// returns the slot holding the name, or the empty slot where it would go
+static int find_slot(const Intern_table *table, const char *name, int length, unsigned hash){
+    int mask = table->slot_count - 1;
+    int index = hash & mask;
+
+    while(table->slots[index] != 0){
+        int atom = table->slots[index] - 1;
+        if(table->hashes[atom] == hash && table->lengths[atom] == length &&
+            memcmp(table->names[atom], name, length) == 0){
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+static int resize_slots(Intern_table *table, int slot_count){
+    int *slots = arena_alloc(table->arena, sizeof(int) * slot_count);
+    if(slots == NULL){
+        return 0;
+    }
+    memset(slots, 0, sizeof(int) * slot_count);
+
+    // the old slots stay in the arena, the atoms are placed again from their hashes
+    table->slots = slots;
+    table->slot_count = slot_count;
+    for(int atom = 0; atom < table->count; atom++){
+        int index = table->hashes[atom] & (slot_count - 1);
+        while(slots[index] != 0){
+            index = (index + 1) & (slot_count - 1);
+        }
+        slots[index] = atom + 1;
+    }
+    return 1;
+}
+
+static int reserve_atom(Intern_table *table){
+    if(table->count < table->capacity){
+        return 1;
+    }
+
+    int new_capacity = table->capacity * 2;
+    char **names = arena_grow(table->arena, table->names,
+        sizeof(char *) * table->capacity, sizeof(char *) * new_capacity);
+    int *lengths = arena_grow(table->arena, table->lengths,
+        sizeof(int) * table->capacity, sizeof(int) * new_capacity);
+    unsigned *hashes = arena_grow(table->arena, table->hashes,
+        sizeof(unsigned) * table->capacity, sizeof(unsigned) * new_capacity);
+    if(names == NULL || lengths == NULL || hashes == NULL){
+        return 0;
+    }
+
+    table->names = names;
+    table->lengths = lengths;
+    table->hashes = hashes;
+    table->capacity = new_capacity;
+    return 1;
+}
+
+// copies the name to the end of the pool, a new block is started when it doesn't fit
+static char *pool_store(Intern_table *table, const char *name, int length){
+    size_t size = length + 1;
+    if(table->pool == NULL || table->pool_size - table->pool_used < size){
+        size_t block_size = size > INTERN_POOL_BLOCK_SIZE ? size : INTERN_POOL_BLOCK_SIZE;
+        table->pool = arena_alloc(table->arena, block_size);
+        if(table->pool == NULL){
+            return NULL;
+        }
+        table->pool_size = block_size;
+        table->pool_used = 0;
+    }
+
+    char *copy = table->pool + table->pool_used;
+    memcpy(copy, name, length);
+    copy[length] = '\0';
+    table->pool_used += size;
+
+    return copy;
+}
+
+Intern_table *init_intern_table(Arena *arena){
+    Intern_table *table = arena_alloc(arena, sizeof(Intern_table));
+    if(table == NULL){
+        return NULL;
+    }
+
+    table->arena = arena;
+    table->pool = NULL;
+    table->pool_used = 0;
+    table->pool_size = 0;
+
+    table->count = 0;
+    table->capacity = 256;
+    table->names = arena_alloc(arena, sizeof(char *) * table->capacity);
+    table->lengths = arena_alloc(arena, sizeof(int) * table->capacity);
+    table->hashes = arena_alloc(arena, sizeof(unsigned) * table->capacity);
+    if(table->names == NULL || table->lengths == NULL || table->hashes == NULL){
+        return NULL;
+    }
+    if(!resize_slots(table, 2 * table->capacity)){
+        return NULL;
+    }
+
+    return table;
+}
+
+// interns the names of PREDEFINED_ATOM into an empty table, returns 0 if out of memory
+int intern_predefined(Intern_table *table){
+    for(int i = 0; i < ATOM_PREDEFINED_COUNT; i++){
+        if(intern(table, predefined_names[i], strlen(predefined_names[i])) != i){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// returns the atom of the name, the name is added if it's new
+// -1 if the system runs out of memory
+int intern(Intern_table *table, const char *name, int length){
+    unsigned hash = hash_name(name, length);
+    int index = find_slot(table, name, length, hash);
+    if(table->slots[index] != 0){
+        return table->slots[index] - 1;
+    }
+
+    // at most half of the slots are taken
+    if(2 * (table->count + 1) > table->slot_count){
+        if(!resize_slots(table, table->slot_count * 2)){
+            return -1;
+        }
+        index = find_slot(table, name, length, hash);
+    }
+    if(!reserve_atom(table)){
+        return -1;
+    }
+
+    char *copy = pool_store(table, name, length);
+    if(copy == NULL){
+        return -1;
+    }
+
+    int atom = table->count++;
+    table->names[atom] = copy;
+    table->lengths[atom] = length;
+    table->hashes[atom] = hash;
+    table->slots[index] = atom + 1;
+
+    return atom;
+}
+
+// returns the atom of the name, ATOM_NONE if it was never interned
+int intern_find(const Intern_table *table, const char *name, int length){
+    int index = find_slot(table, name, length, hash_name(name, length));
+    return table->slots[index] - 1;
+}
+
+char *intern_name(Intern_table *table, int atom){
+    return table->names[atom];
+}
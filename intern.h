@@ -0,0 +1,58 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "arena.h"
+
+// no name has this atom
+#define ATOM_NONE -1
+
+// size of the blocks the interned names are packed into
+#define INTERN_POOL_BLOCK_SIZE (64 * 1024)
+
+// names the compiler looks for itself, interned first so their atoms are fixed
+typedef enum {
+    ATOM_MAIN,
+    ATOM_WRITE,
+    ATOM_READ_STR,
+    ATOM_READ_NUM,
+    ATOM_FLOOR,
+    ATOM_STR,
+    ATOM_LENGTH,
+    ATOM_SUBSTRING,
+    ATOM_STRCMP,
+    ATOM_ORD,
+    ATOM_CHR,
+    ATOM_PREDEFINED_COUNT
+} PREDEFINED_ATOM;
+
+// every distinct name is stored once and numbered densely from 0,
+// two names are equal exactly when their atoms are
+typedef struct intern_table {
+    Arena *arena;
+
+    // names are packed one after another, NUL-terminated, into the current block
+    char *pool;
+    size_t pool_used;
+    size_t pool_size;
+
+    char **names;       // atom -> name in the pool
+    int *lengths;
+    unsigned *hashes;
+    int count;
+    int capacity;
+
+    int *slots;         // open addressing, atom + 1, 0 is an empty slot
+    int slot_count;     // power of two
+} Intern_table;
+
+Intern_table *init_intern_table(Arena *arena);
+int intern_predefined(Intern_table *table);
+int intern(Intern_table *table, const char *name, int length);
+int intern_find(const Intern_table *table, const char *name, int length);
+char *intern_name(Intern_table *table, int atom);
+
+static inline int atom_is_builtin_function(int atom){
+    return atom >= ATOM_WRITE && atom <= ATOM_CHR;
+}
+
+#endif
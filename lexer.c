@@ -1,756 +1,637 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <string.h>
 #include "lexer.h"
+#include "lexer_dfa.h"
+#include "lexer_parallel.h"
 #include "symtable.h"
 #include "token.h"
+#include "utils.h"
 
-char *keyword_array[] = {"class", "if", "else", "is", "null", 
-                "return", "var", "while", "Ifj", "static", 
-                "import", "for", "Num", "String", "Null"
-};
-
-Lexer *init_lexer(Symtable *symtable){
-    Lexer *lexer = malloc(sizeof(Lexer));
-    if(lexer == NULL){
+static Lexer *new_lexer(Arena *arena, Symtable *symtable, Scope_tree *scopes, Source *source){
+    Lexer *lexer = arena_alloc(arena, sizeof(Lexer));
+    if(lexer == NULL || scopes == NULL){
         return NULL;
     }
 
     lexer->symtable = symtable;
+    lexer->arena = arena;
+    lexer->scopes = scopes;
+
+    lexer->source = source;
+    lexer->cursor = 0;
+    lexer->chunk_end = source->length;
+    lexer->at_end = 0;
 
-    lexer->lexeme_length = 0;
+    lexer->token_start = 0;
     lexer->current_col = 1;
     lexer->current_row = 1;
 
     lexer->token_count = 0;
     lexer->token_table = NULL;
+    lexer->token_capacity = 0;
+    lexer->store.kinds = NULL;
+    lexer->store.subtypes = NULL;
+    lexer->store.capacity = 0;
     lexer->token_index = 0;
+    lexer->streaming = 0;
 
-    lexer->lexeme = NULL;
     lexer->error = 0;
 
-    lexer->scope = 0;
-    lexer->max_scope = 0;
-    lexer->previous_scope_arr = NULL;
-    lexer->scope_index = 0; 
+    lexer->scope = SCOPE_ROOT;
 
     lexer->newlines_in_multiline = 0;
 
 
-    lexer->left_multiline_comment_end_sequence = 0;
-    lexer->left_multiline_comment_start_sequence = 0;
+    lexer->multiline_comment_depth = 0;
+    lexer->first_line_end = -1;
+
+    lexer->keep_trivia = 0;
+    lexer->trivia_start = 0;
+    lexer->trivia_table = NULL;
+    lexer->trivia_count = 0;
+    lexer->trivia_capacity = 0;
+
+    lexer_dfa_build();
 
     return lexer;
 }
 
-#include <stdlib.h>
-
-int* extend_array(int *arr, int new_size, int new_scope_id, int prev_index) {
-    // Allocate new array
-    int *new_arr = (int*)malloc(new_size * sizeof(int));
-    if (!new_arr) {
-        perror("malloc failed");
-        exit(1);
-    }
+Lexer *init_lexer(Symtable *symtable, Source *source){
+    return new_lexer(symtable->arena, symtable, symtable->scopes, source);
+}
 
-    // Copy old values
-    for (int i = 0; i < prev_index; i++) {
-        new_arr[i] = arr[i];
+// a lexer for the part of the source between start and end, everything it allocates comes from arena
+// it has no symtable and keeps its own scopes, lexer_start_parallel() splices its tokens in
+Lexer *init_chunk_lexer(Arena *arena, Source *source, size_t start, size_t end){
+    Lexer *lexer = new_lexer(arena, NULL, init_chunk_scope_tree(arena), source);
+    if(lexer == NULL){
+        return NULL;
     }
 
-    // Add the previous scope at prev_index
-    new_arr[prev_index] = new_scope_id;
+    lexer->cursor = start;
+    lexer->token_start = start;
+    lexer->chunk_end = end;
 
-    // Free old array
-    free(arr);
-
-    return new_arr;
+    return lexer;
 }
 
-void print_scope_array(int *arr, int size) {
-    printf("Previous scopes: [");
-    for (int i = 0; i < size; i++) {
-        printf("%d", arr[i]);
-        if (i < size - 1) {
-            printf(", ");
+// returns a new empty token at the end of the token table
+Token *add_token_to_token_table(Lexer *lexer){
+    Token *token;
+
+    // streaming mode has no token table, only the lookahead window points back to the tokens,
+    // each token is still its own arena allocation since the AST keeps pointers to them,
+    // so token memory grows with the source like in batch mode, just without the table doubling
+    if(lexer->streaming){
+        token = arena_alloc(lexer->arena, sizeof(Token));
+        if(token == NULL){
+            return NULL;
         }
+        lexer->token_ring[lexer->token_count % LEXER_RING_SIZE] = token;
+        lexer->token_count++;
+        return token;
+    }
+
+    // the table doubles whenever it's full
+    if(lexer->token_count == lexer->token_capacity){
+        int new_capacity = lexer->token_capacity == 0 ? 1024 : lexer->token_capacity * 2;
+        Token *token_table = arena_grow(lexer->arena, lexer->token_table,
+            sizeof(Token) * lexer->token_capacity, sizeof(Token) * new_capacity);
+        if(token_table == NULL){
+            return NULL;
+        }
+        lexer->token_table = token_table;
+        lexer->token_capacity = new_capacity;
     }
-    printf("]\n");
-}
 
-
-
-void extend_lexeme(Lexer *lexer, char currect_char){
-    lexer->lexeme_length++;
-    lexer->lexeme = realloc(lexer->lexeme, sizeof(char) * lexer->lexeme_length + 1);
-    lexer->lexeme[lexer->lexeme_length - 1] = currect_char;
-    lexer->lexeme[lexer->lexeme_length] = '\0';
-}
-
-void add_token_to_token_table(Lexer *lexer, Token *token){
+    token = &(lexer->token_table[lexer->token_count]);
     lexer->token_count++;
-    lexer->token_table = realloc(lexer->token_table, sizeof(Token) * lexer->token_count);
-    lexer->token_table[lexer->token_count - 1] = *token;
+
+    return token;
 }
 
-void print_token_table(Lexer *lexer){
-    printf("%i\n", lexer->token_count);
-    for(int i = 0; i < lexer->token_count; i++){
-        print_token(&(lexer->token_table[i]));
+// puts the kind and subtype of the token at index into the token store
+// chunk lexers have no parser to feed, the store is filled when they're spliced in
+void lexer_store_kind(Lexer *lexer, int index, Token *token){
+    Token_store *store = &lexer->store;
+    if(lexer->symtable == NULL){
+        return;
+    }
+    if(lexer->streaming){
+        index %= LEXER_RING_SIZE;
     }
-}
 
-Token *get_next_token(Lexer *lexer){
-    Token *token;
-    
-    // if theres no more tokens to pass return null
-    if(lexer->token_index == lexer->token_count){
-        return NULL;
+    if(index >= store->capacity){
+        int new_capacity = store->capacity == 0 ? 256 : store->capacity * 2;
+        unsigned char *kinds = arena_grow(lexer->arena, store->kinds, store->capacity, new_capacity);
+        unsigned char *subtypes = arena_grow(lexer->arena, store->subtypes, store->capacity, new_capacity);
+        if(kinds == NULL || subtypes == NULL){
+            lexer->error = ERR_T_MALLOC_ERR;
+            return;
+        }
+        store->kinds = kinds;
+        store->subtypes = subtypes;
+        store->capacity = new_capacity;
     }
-    
-    token = &(lexer->token_table[lexer->token_index]);
-    lexer->token_index++;
 
-    return token;
+    store->kinds[index] = token->token_type;
+    store->subtypes[index] = token->token_subtype;
 }
 
-Token *get_lookahead_token(Lexer *lexer){
-    Token *token;
-    
-    // if theres no more tokens to pass return null
-    if(lexer->token_index == lexer->token_count){
-        return NULL;
+// copies the lexeme of the token out of the source buffer
+char *materialize_lexeme(Lexer *lexer, Token *token){
+    if(token->token_lexeme != NULL){
+        return token->token_lexeme;
     }
-    
-    token = &(lexer->token_table[lexer->token_index]);
-    return token;
-}
-
-void read_next_char(Lexer *lexer){
-    lexer->current_char = getchar();
-    lexer->current_col++;
 
-    if(lexer->current_char == '{'){
-        lexer->scope_index++;
-        lexer->max_scope++;
-        lexer->scope_id = lexer->max_scope + 100;
-        lexer->previous_scope_arr = extend_array(
-            lexer->previous_scope_arr, 
-            lexer->scope_index, 
-            lexer->scope_id, 
-            lexer->scope_index - 1);
-        
-        lexer->scope = lexer->scope_id;
-    } else if(lexer->current_char == '}'){
-        lexer->scope_index--;
-        lexer->scope = lexer->previous_scope_arr[lexer->scope_index - 1];
+    token->token_lexeme = arena_strndup(lexer->arena, lexer->source->buffer + token->lexeme_offset, token->lexeme_length);
+    if(token->token_lexeme == NULL){
+        lexer->error = ERR_T_MALLOC_ERR;
+        return NULL;
     }
 
-    extend_lexeme(lexer, lexer->current_char);
+    return token->token_lexeme;
 }
 
-int lexer_start(Lexer *lexer){
-    // reset lexeme
-    lexer->lexeme = NULL;
-    lexer->lexeme_length = 0; 
-
-    read_next_char(lexer);    
+// returns the subtype between first and last spelled like the current lexeme, SUB_T_NONE if there's none
+static TOKEN_SUBTYPE find_spelling_in(Lexer *lexer, TOKEN_SUBTYPE first, TOKEN_SUBTYPE last){
+    const char *lexeme = lexer->source->buffer + lexer->token_start;
+    int lexeme_length = lexer->cursor - lexer->token_start;
 
-    // newline
-    if(lexer->current_char == '\n'){ // ok :)
-        final_state_end_of_line(lexer);
-    }
-    // whitespace
-    else if(isspace(lexer->current_char)){ // ok
-        lexer_start(lexer);
-    }
-    // 1-9
-    else if(lexer->current_char >= '1' && lexer->current_char <= '9'){
-        state_digit(lexer);
-    }
-    // 0
-    else if(lexer->current_char == '0'){
-        state_zero(lexer);
-    }
-    // "
-    else if(lexer->current_char == '"'){
-        state_string_reading(lexer);
-    }
-    // ,
-    else if(lexer->current_char == ','){
-        final_state_comma(lexer);
-    }
-    // (){}
-    else if(lexer->current_char == '(' || lexer->current_char == ')' || lexer->current_char == '{' || lexer->current_char == '}'){
-        final_state_brackets(lexer);
-    }
-    // /
-    else if(lexer->current_char == '/'){
-        state_comment_start(lexer);
-    }
-    // _
-    else if(lexer->current_char == '_'){
-        state_global1(lexer);
-    }
-    // !
-    else if(lexer->current_char == '!'){
-        state_exclamation_operator(lexer);
-    }
-    // +-*.
-    else if(lexer->current_char == '+' || lexer->current_char == '-' || lexer->current_char == '*' || lexer->current_char == '.'){
-        final_state_operator(lexer);
-    }
-    // ><=
-    else if(lexer->current_char == '>' || lexer->current_char == '<' || lexer->current_char == '='){
-        state_two_char_operator(lexer);
-    }
-    // a-z A-Z
-    else if((lexer->current_char >= 'a' && lexer->current_char <= 'z') || (lexer->current_char >= 'A' && lexer->current_char <= 'Z')){
-        state_id_start(lexer);
-    }
-    else {
-        if(lexer->current_char != EOF){
-            lexer->error = 1;
+    for(int i = first; i <= (int)last; i++){
+        if((int)strlen(token_spellings[i]) == lexeme_length && memcmp(token_spellings[i], lexeme, lexeme_length) == 0){
+            return i;
         }
     }
-
-    return lexer->error;
+    return SUB_T_NONE;
 }
 
+static TOKEN_SUBTYPE find_keyword(Lexer *lexer){
+    return find_spelling_in(lexer, SUB_T_FIRST_KEYWORD, SUB_T_LAST_KEYWORD);
+}
 
+static TOKEN_SUBTYPE find_punctuation(Lexer *lexer){
+    TOKEN_SUBTYPE subtype = find_spelling_in(lexer, SUB_T_FIRST_PUNCTUATION, SUB_T_LAST_PUNCTUATION);
 
-// FSM STATES
+    // "is" is lexed as a keyword but ends up as an operator
+    if(subtype == SUB_T_NONE){
+        subtype = find_keyword(lexer);
+    }
+    return subtype;
+}
 
-void final_state_end_of_line(Lexer *lexer){
-    lexer->current_row++;
-    lexer->current_col = 1;
-    Token *token = create_token(TOKEN_T_EOL, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
-    
+// records the source skipped since the last token, if there is any
+static void add_trivia(Lexer *lexer, size_t end){
+    if(end <= lexer->trivia_start){
+        return;
+    }
 
-}
+    if(lexer->trivia_count == lexer->trivia_capacity){
+        int new_capacity = lexer->trivia_capacity == 0 ? 64 : lexer->trivia_capacity * 2;
+        Trivia *trivia_table = arena_grow(lexer->arena, lexer->trivia_table,
+            sizeof(Trivia) * lexer->trivia_capacity, sizeof(Trivia) * new_capacity);
+        if(trivia_table == NULL){
+            lexer->error = ERR_T_MALLOC_ERR;
+            return;
+        }
+        lexer->trivia_table = trivia_table;
+        lexer->trivia_capacity = new_capacity;
+    }
 
-void final_state_comma(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_COMMA, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
+    Trivia *trivia = &lexer->trivia_table[lexer->trivia_count++];
+    trivia->start = lexer->trivia_start;
+    trivia->end = end;
+    trivia->next_token = lexer->token_count;
 }
 
-void final_state_brackets(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_BRACKET, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
+// from now on the whitespace and comments between tokens are kept in trivia_table,
+// has to be called before lexing starts, big sources are then lexed by one thread
+void lexer_keep_trivia(Lexer *lexer){
+    lexer->keep_trivia = 1;
+    lexer->trivia_start = lexer->cursor;
 }
 
-
-void final_state_identif(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_IDENTIFIER, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    Symbol *symbol = search_table(token, lexer->symtable);
-    if(symbol == NULL){
-        token = create_token(TOKEN_T_IDENTIFIER, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-
-        symbol = lexer_create_identifier_sym_from_token(token);
-        insert_into_symtable(lexer->symtable, symbol);
-    }else {
-        add_symbol_occurence(symbol, lexer->current_row, lexer->current_col, lexer->scope);
+void print_trivia_table(Lexer *lexer){
+    printf("%i\n", lexer->trivia_count);
+    for(int i = 0; i < lexer->trivia_count; i++){
+        Trivia *trivia = &lexer->trivia_table[i];
+        printf("%zu-%zu before token %i: \"%.*s\"\n", trivia->start, trivia->end, trivia->next_token,
+            (int)(trivia->end - trivia->start), lexer->source->buffer + trivia->start);
     }
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
 }
 
-void final_state_keyword(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_KEYWORD, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
-}
-
-void state_id_start(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(
-        (lexer->current_char >= 'a' && lexer->current_char <= 'z' )||
-        (lexer->current_char >= 'A' && lexer->current_char <= 'Z' )||
-        (lexer->current_char >= '0' && lexer->current_char <= '9' )||
-        lexer->current_char == '_'
-    ) {
-        read_next_char(lexer);
-        state_id_start(lexer);
-    } else {
-        state_id_read(lexer);
+// stores a token for the lexeme between token_start and the cursor
+// the lexeme isn't copied, tokens with a known spelling (subtype) point to token_spellings
+Token *emit_token(Lexer *lexer, TOKEN_TYPE token_type, int line_number, TOKEN_SUBTYPE subtype){
+    if(lexer->keep_trivia){
+        add_trivia(lexer, lexer->token_start);
+        lexer->trivia_start = lexer->cursor;
     }
-}
 
-void state_id_read(Lexer *lexer){
-    int not_id = 0;
-    for(int i = 0; i < 15; i++){
-        if(strcmp(lexer->lexeme, keyword_array[i]) == 0){
-            not_id = 1;
-            if(strcmp(lexer->lexeme, "is") == 0){
-                final_state_operator(lexer);
-            } else {
-                final_state_keyword(lexer);
-            }
-        }
+    Token *token = add_token_to_token_table(lexer);
+    if(token == NULL){
+        lexer->error = ERR_T_MALLOC_ERR;
+        return NULL;
     }
 
-    if(!not_id) {
-        final_state_identif(lexer);
-    }
+    int lexeme_length = lexer->cursor - lexer->token_start;
+    init_token(token, token_type, lexer->token_start, lexeme_length, line_number, lexer->current_col, lexer->scope);
+    token->token_subtype = subtype;
+    token->token_lexeme = token_spellings[subtype];
+    lexer_store_kind(lexer, lexer->token_count - 1, token);
+
+    return token;
 }
 
-void final_state_global_identif(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_GLOBAL_VAR, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    Symbol *symbol = search_table(token, lexer->symtable);
-    if (symbol == NULL){
-        symbol = lexer_create_global_var_sym_from_token(token);
+void print_token_table(Lexer *lexer){
+    printf("%i\n", lexer->token_count);
+    for(int i = 0; i < lexer->token_count; i++){
+        print_token(&(lexer->token_table[i]));
     }
-    add_token_to_token_table(lexer, token);
-    insert_into_symtable(lexer->symtable, symbol);
-    lexer_start(lexer);
 }
 
-int state_global1(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '_'){
-        state_global2(lexer);
-    } else {
-        lexer->error = 1;
+// in streaming mode lexes until the token at index is in the ring
+// returns 0 if the input ends (or fails) before that
+static int lexer_fill_until(Lexer *lexer, int index){
+    while(lexer->token_count <= index){
+        if(!lexer_next_token(lexer)){
+            return 0;
+        }
     }
-    
-    return lexer->error;
+    return 1;
 }
 
-int state_global2(Lexer *lexer){
-    read_next_char(lexer);
-    if(
-        (lexer->current_char >= 'a' && lexer->current_char <= 'z' )||
-        (lexer->current_char >= 'A' && lexer->current_char <= 'Z' )||
-        (lexer->current_char >= '0' && lexer->current_char <= '9' )||
-        lexer->current_char == '_'
-    ) {
-        state_global3(lexer);
-    } else {
-        lexer->error = 1;
+Token *get_next_token(Lexer *lexer){
+    Token *token = get_lookahead_token(lexer);
+    
+    if(token != NULL){
+        lexer->token_index++;
     }
 
-    return lexer->error;
+    return token;
 }
 
-int state_global3(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(
-        (lexer->current_char >= 'a' && lexer->current_char <= 'z' )||
-        (lexer->current_char >= 'A' && lexer->current_char <= 'Z' )||
-        (lexer->current_char >= '0' && lexer->current_char <= '9' )||
-        lexer->current_char == '_'
-    ) {
-        read_next_char(lexer);
-        state_global3(lexer);
+Token *get_lookahead_token(Lexer *lexer){
+    Token *token;
+
+    if(lexer->streaming){
+        if(!lexer_fill_until(lexer, lexer->token_index)){
+            return NULL;
+        }
+        token = lexer->token_ring[lexer->token_index % LEXER_RING_SIZE];
     } else {
-        final_state_global_identif(lexer);
+        // if theres no more tokens to pass return null
+        if(lexer->token_index == lexer->token_count){
+            return NULL;
+        }
+        token = &(lexer->token_table[lexer->token_index]);
     }
 
-    return lexer->error;
-}
+    // numbers and strings get their lexeme once the parser asks for them
+    if(materialize_lexeme(lexer, token) == NULL){
+        return NULL;
+    }
 
-void final_state_number(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_NUM, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
+    return token;
 }
 
-int state_zero(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(lexer->current_char >= '0' && lexer->current_char <= '9'){
-        read_next_char(lexer);
-        state_digit(lexer);
-    }
-    else if(lexer->current_char == 'x'){
-        read_next_char(lexer);
-        state_hex_prefix(lexer);
-    }
-    else if(lexer->current_char == '.'){
-        read_next_char(lexer);
-        state_dot_arrived(lexer);
+// returns the store index of the lookahead token, -1 if the input is over
+static int lookahead_store_index(Lexer *lexer){
+    if(lexer->streaming){
+        if(!lexer_fill_until(lexer, lexer->token_index)){
+            return -1;
+        }
+        return lexer->token_index % LEXER_RING_SIZE;
     }
-    else {
-        final_state_number(lexer);
+    if(lexer->token_index == lexer->token_count){
+        return -1;
     }
+    return lexer->token_index;
+}
 
-    return lexer->error;
+// the kind of the lookahead token without touching the token itself, -1 at the end
+int lexer_lookahead_kind(Lexer *lexer){
+    int index = lookahead_store_index(lexer);
+    return index < 0 ? -1 : lexer->store.kinds[index];
 }
 
-int state_digit(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(lexer->current_char >= '0' && lexer->current_char <= '9'){
-        read_next_char(lexer);
-        state_digit(lexer);
-    }
-    else if(lexer->current_char == '.'){
-        read_next_char(lexer);
-        state_dot_arrived(lexer);
-    }
-    else if(lexer->current_char == 'E' || lexer->current_char == 'e'){
-        read_next_char(lexer);
-        state_exponent_prefix(lexer);
-    }
-    else {
-        final_state_number(lexer);
-    }
+// the subtype of the lookahead token, SUB_T_NONE at the end too
+TOKEN_SUBTYPE lexer_lookahead_subtype(Lexer *lexer){
+    int index = lookahead_store_index(lexer);
+    return index < 0 ? SUB_T_NONE : lexer->store.subtypes[index];
+}
 
-    return lexer->error;
+// steps back by one token, the ring always keeps the last passed token
+void unget_token(Lexer *lexer){
+    lexer->token_index--;
 }
 
-int state_hex_prefix(Lexer *lexer){
-    read_next_char(lexer);
-    if((lexer->current_char >= '0' && lexer->current_char <= '9') ||
-       (lexer->current_char >= 'a' && lexer->current_char <= 'f') ||
-       (lexer->current_char >= 'A' && lexer->current_char <= 'F')
-    ){
-        state_hex_numba(lexer);
-    } else {
-        lexer->error = 1;
+// lexes whatever the parser didn't ask for, so the symtable
+// and lexical errors end up the same as with the whole table built upfront
+int lexer_finish(Lexer *lexer){
+    if(lexer->streaming){
+        while(lexer_next_token(lexer)){
+        }
     }
     return lexer->error;
 }
 
-int state_hex_numba(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if((lexer->current_char >= '0' && lexer->current_char <= '9') ||
-       (lexer->current_char >= 'a' && lexer->current_char <= 'f') ||
-       (lexer->current_char >= 'A' && lexer->current_char <= 'F')
-    ){
-        read_next_char(lexer);
-        state_hex_numba(lexer);
-    } else {
-        final_state_number(lexer);
+// returns the next byte without consuming it, EOF only once the whole source is read
+int peek_next_char(Lexer *lexer){
+    if(lexer->cursor < lexer->source->length){
+        return (unsigned char)lexer->source->buffer[lexer->cursor];
     }
-
-    return lexer->error;
+    return EOF;
 }
 
-int state_dot_arrived(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char >= '0' && lexer->current_char <= '9'){
-        state_decimal_part(lexer);
+void read_next_char(Lexer *lexer){
+    if(lexer->cursor < lexer->source->length){
+        lexer->current_char = lexer->source->buffer[lexer->cursor++];
     } else {
-        lexer->error = 1;
+        lexer->current_char = EOF;
     }
-    return lexer->error;
-}
+    lexer->current_col++;
 
-int state_decimal_part(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(lexer->current_char >= '0' && lexer->current_char <= '9'){
-        read_next_char(lexer);
-        state_decimal_part(lexer);
-    }
-    else if(lexer->current_char == 'e' || lexer->current_char == 'E'){
-        read_next_char(lexer);
-        state_exponent_prefix(lexer);
-    }
-    else {
-        final_state_number(lexer);
+    if(lexer->current_char == '{'){
+        int scope = scope_open(lexer->scopes, lexer->scope);
+        if(scope < 0){
+            lexer->error = ERR_T_MALLOC_ERR;
+            return;
+        }
+        lexer->scope = scope;
+    } else if(lexer->current_char == '}'){
+        lexer->scope = scope_parent(lexer->scopes, lexer->scope);
     }
-    return lexer->error;
 }
 
-int state_exponent_prefix(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char >= '0' && lexer->current_char <= '9'){
-        state_exponent(lexer);
-    } else {
-        lexer->error = 1;
+int lexer_start(Lexer *lexer){
+    // big sources are split between threads, unless trivia is kept
+    if(lexer->source->length >= LEXER_PARALLEL_MIN_SIZE && !lexer->keep_trivia){
+        return lexer_start_parallel(lexer);
     }
-    return lexer->error;
-}
 
-int state_exponent(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(lexer->current_char >= '0' && lexer->current_char <= '9'){
-        read_next_char(lexer);
-        state_exponent(lexer);
-    } else {
-        final_state_number(lexer);
+    // one token per iteration, the stack depth stays constant
+    while(lexer_next_token(lexer)){
     }
+
     return lexer->error;
 }
 
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// runs one action of the DFA, returns 1 when the lexer stops for this token
+static int lexer_run_action(Lexer *lexer, LEXER_ACTION action){
+    switch(action){
+        case LEX_ACTION_END:
+            lexer->at_end = 1;
+            if(lexer->keep_trivia){
+                add_trivia(lexer, lexer->cursor);
+                lexer->trivia_start = lexer->cursor;
+            }
+            return 1;
+        case LEX_ACTION_STRING_NEWLINE:
+            lexer->newlines_in_multiline++;
+            lexer->current_row++;
+            return 0;
+        case LEX_ACTION_COMMENT_OPEN:
+            lexer->multiline_comment_depth++;
+            return 0;
+        case LEX_ACTION_COMMENT_CLOSE:
+            lexer->multiline_comment_depth--;
+            return 0;
+        case LEX_ACTION_COMMENT_END:
+            final_state_comment(lexer);
+            return 1;
+        case LEX_ACTION_COMMENT_NEWLINE:
+            if(lexer->multiline_comment_depth == 0){
+                final_state_comment(lexer);
+                return 1;
+            }
+            lexer->current_row++;
+            return 0;
+        case LEX_ACTION_COMMENT_CONTROL:
+            if(lexer->multiline_comment_depth == 0){
+                final_state_comment(lexer);
+            } else {
+                lexer->error = ERR_T_LEX_ERR;
+            }
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// emits the token recognised in an accepting state, returns 0 if the state isn't one
+static int lexer_accept(Lexer *lexer, LEXER_ACCEPT accept){
+    switch(accept){
+        case LEX_ACCEPT_EOL:
+            final_state_end_of_line(lexer);
+            return 1;
+        case LEX_ACCEPT_COMMA:
+            final_state_comma(lexer);
+            return 1;
+        case LEX_ACCEPT_BRACKET:
+            final_state_brackets(lexer);
+            return 1;
+        case LEX_ACCEPT_OPERATOR:
+            final_state_operator(lexer);
+            return 1;
+        case LEX_ACCEPT_WORD:
+            final_state_word(lexer);
+            return 1;
+        case LEX_ACCEPT_GLOBAL:
+            final_state_global_identif(lexer);
+            return 1;
+        case LEX_ACCEPT_NUMBER:
+            final_state_number(lexer);
+            return 1;
+        case LEX_ACCEPT_STRING:
+            final_state_string(lexer);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// drives the DFA from the start state until a token is emitted,
+// each character is classified and looked up in the transition table
+int lexer_next_token(Lexer *lexer){
+    // nothing past the end of input or an error is lexed, the parser may still ask in streaming mode
+    if(lexer->at_end || lexer->error != 0){
+        return 0;
+    }
+
+    int token_count = lexer->token_count;
+    LEXER_STATE state = LEX_S_START;
+    lexer->token_start = lexer->cursor;
+
+    for(;;){
+        // long strings, comments and indentation are skipped in one go
+        const Lexer_run *run = lexer_dfa.runs[state];
+        if(run != NULL){
+            size_t run_end = lexer_scan_run(run, lexer->source->buffer, lexer->cursor, lexer->source->length);
+            lexer->current_col += run_end - lexer->cursor;
+            lexer->cursor = run_end;
+            if(state == LEX_S_START){
+                lexer->token_start = lexer->cursor;
+            }
+        }
 
-void final_state_string(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
+        LEXER_STATE next = lexer_dfa.transitions[state][lexer_char_class(peek_next_char(lexer))];
+
+        // the character can't continue the lexeme, it's left for the next token
+        if(next == LEX_S_NONE){
+            if(!lexer_accept(lexer, lexer_dfa.accepts[state])){
+                lexer->error = ERR_T_LEX_ERR;
+            }
+            break;
+        }
 
-    if(strcmp(lexer->lexeme, "\"\"") == 0 && lexer->current_char == '"'){
-        puts("smetu1");
         read_next_char(lexer);
-        state_multiline_string_reading(lexer);
-    } else {
-        Token *token = create_token(TOKEN_T_STRING, lexer->lexeme, lexer->lexeme_length, lexer->current_row - lexer->newlines_in_multiline, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-        add_token_to_token_table(lexer, token);
-        lexer->newlines_in_multiline = 0;
+        if(lexer->error != 0){
+            break;
+        }
+        state = next;
 
-        lexer_start(lexer);
+        // whitespace, the lexeme starts at the next character
+        if(state == LEX_S_START){
+            lexer->token_start = lexer->cursor;
+        } else if(lexer_dfa.actions[state] != LEX_ACTION_NONE && lexer_run_action(lexer, lexer_dfa.actions[state])){
+            break;
+        }
     }
+
+    // every call either emits a token or stops the lexer
+    return lexer->error == 0 && lexer->token_count > token_count;
 }
 
-int state_string_reading(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char > 31 && lexer->current_char != 34){
-        state_string_reading(lexer);
-    } else if(lexer->current_char == '\\'){
-        state_special_symbol(lexer);
-    } else if(lexer->current_char == '"'){
-        final_state_string(lexer);
-    } else {
-        lexer->error = 1;
-    }
 
-    return lexer->error;
-}
 
-int state_special_symbol(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '"' || lexer->current_char == 'n' || lexer->current_char == 'r' || lexer->current_char == 't' || lexer->current_char == '\\' ){
-        state_string_reading(lexer);
-    } else if (lexer->current_char == 'x'){
-        state_string_hex_prefix(lexer);
-    } else {
-        lexer->error = 1;
+// FINAL STATES, they emit the token between token_start and the cursor
+
+void final_state_end_of_line(Lexer *lexer){
+    if(lexer->first_line_end < 0){
+        lexer->first_line_end = lexer->token_count;
     }
-    return lexer->error;
+    lexer->current_row++;
+    lexer->current_col = 1;
+    emit_token(lexer, TOKEN_T_EOL, lexer->current_row, SUB_T_EOL);
 }
 
-int state_string_hex_prefix(Lexer *lexer){
-    read_next_char(lexer);
-    if((lexer->current_char >= '0' && lexer->current_char <= '9') ||
-       (lexer->current_char >= 'a' && lexer->current_char <= 'f') ||
-       (lexer->current_char >= 'A' && lexer->current_char <= 'F')
-    ){
-        state_string_hex_number(lexer);
-    } else {
-        lexer->error = 1;
-    }
-    return lexer->error;
+void final_state_comma(Lexer *lexer){
+    emit_token(lexer, TOKEN_T_COMMA, lexer->current_row, find_punctuation(lexer));
 }
 
-int state_string_hex_number(Lexer *lexer){
-    read_next_char(lexer);
-    if((lexer->current_char >= '0' && lexer->current_char <= '9') ||
-       (lexer->current_char >= 'a' && lexer->current_char <= 'f') ||
-       (lexer->current_char >= 'A' && lexer->current_char <= 'F')
-    ){
-        state_string_reading(lexer);
-    } else {
-        lexer->error = 1;
-    }
-    return lexer->error;
+void final_state_brackets(Lexer *lexer){
+    emit_token(lexer, TOKEN_T_BRACKET, lexer->current_row, find_punctuation(lexer));
 }
 
-int state_multiline_string_reading(Lexer *lexer){
-    puts("state_multiline_string_reading");
-    read_next_char(lexer);
-    if((lexer->current_char > 31 && lexer->current_char != 34) || isspace(lexer->current_char) ){
-        if(lexer->current_char == '\n'){
-            lexer->newlines_in_multiline++;
-            lexer->current_row++;
-        }
-        state_multiline_string_reading(lexer);
-    } 
-    else if(lexer->current_char == '\\'){
-        state_multiline_special_symbol(lexer);
-    } 
-    else if(lexer->current_char == '"'){
-        state_multiline_string1(lexer);
+
+// puts an identifier or a global variable into the symtable, or records another occurence of it
+// chunk lexers have no symtable, their identifiers are registered once the chunk is spliced in
+void lexer_register_symbol(Lexer *lexer, Token *token){
+    if(lexer->symtable == NULL){
+        return;
     }
-    else {
-        puts("SME v ELSE");
-        lexer->error = 1;
+    // the name is stored once in the pool, the token and its symbol share it
+    int atom = intern(lexer->symtable->names, lexer->source->buffer + token->lexeme_offset, token->lexeme_length);
+    if(atom == ATOM_NONE){
+        lexer->error = ERR_T_MALLOC_ERR;
+        return;
     }
+    token->atom = atom;
+    token->token_lexeme = intern_name(lexer->symtable->names, atom);
 
-    return lexer->error;
-}
-
-int state_multiline_string1(Lexer *lexer){
-    puts("state_multiline_string1");
-    read_next_char(lexer);
-    if(lexer->current_char == '"'){
-        state_multiline_string2(lexer);
+    Symbol *symbol = search_table(token, lexer->symtable);
+    if(token->token_type == TOKEN_T_GLOBAL_VAR){
+        if (symbol == NULL){
+            symbol = lexer_create_global_var_sym_from_token(&lexer->symtable->symbol_pool, token, lexer->token_count - 1);
+        }
+        if(symbol == NULL || !insert_into_symtable(lexer->symtable, symbol)){
+            lexer->error = ERR_T_MALLOC_ERR;
+        }
+    } else if(symbol == NULL){
+        symbol = lexer_create_identifier_sym_from_token(&lexer->symtable->symbol_pool, token, lexer->token_count - 1);
+        if(symbol == NULL || !insert_into_symtable(lexer->symtable, symbol)){
+            lexer->error = ERR_T_MALLOC_ERR;
+        }
     } else {
-        lexer->error = 1;
+        add_symbol_occurence(lexer->arena, symbol, token->token_line_number,
+            token->token_col_number + token->lexeme_length, token->scope, lexer->token_count - 1);
     }
-    return lexer->error;
 }
 
-int state_multiline_string2(Lexer *lexer){
-    puts("state_multiline_string2");
-    read_next_char(lexer);
-    if(lexer->current_char == '"'){
-        final_state_string(lexer);
-    } else {
-        lexer->error = 1;
+// decodes a number or a string once per distinct spelling,
+// chunk lexers leave it for the splice like identifiers
+void lexer_register_literal(Lexer *lexer, Token *token){
+    if(lexer->symtable == NULL){
+        return;
     }
-    return lexer->error;
-}
 
-int state_multiline_special_symbol(Lexer *lexer){
-    puts("state_multiline_special_symbol");
-    read_next_char(lexer);
-    if(lexer->current_char == '"' || lexer->current_char == 'n' || lexer->current_char == 'r' || lexer->current_char == 't' || lexer->current_char == '\\' ){
-        state_multiline_string_reading(lexer);
-    } else if (lexer->current_char == 'x'){
-        state_multiline_string_hex_prefix(lexer);
+    const char *spelling = lexer->source->buffer + token->lexeme_offset;
+    if(token->token_type == TOKEN_T_NUM){
+        token->literal = literal_add_number(lexer->symtable->literals, spelling, token->lexeme_length);
     } else {
-        lexer->error = 1;
+        token->literal = literal_add_string(lexer->symtable->literals, spelling, token->lexeme_length);
     }
-    return lexer->error;
-}
-
-int state_multiline_string_hex_prefix(Lexer *lexer){
-    puts("state_multiline_string_hex_prefix");
-    read_next_char(lexer);
-    if((lexer->current_char >= '0' && lexer->current_char <= '9') ||
-       (lexer->current_char >= 'a' && lexer->current_char <= 'f') ||
-       (lexer->current_char >= 'A' && lexer->current_char <= 'F')
-    ){
-        state_multiline_string_hex_number(lexer);
-    } else {
-        lexer->error = 1;
+    if(token->literal == LITERAL_NONE){
+        lexer->error = ERR_T_MALLOC_ERR;
     }
-    return lexer->error;
 }
 
-int state_multiline_string_hex_number(Lexer *lexer){
-    puts("state_multiline_string_hex_number");
-    read_next_char(lexer);
-    if((lexer->current_char >= '0' && lexer->current_char <= '9') ||
-       (lexer->current_char >= 'a' && lexer->current_char <= 'f') ||
-       (lexer->current_char >= 'A' && lexer->current_char <= 'F')
-    ){
-        state_multiline_string_reading(lexer);
-    } else {
-        lexer->error = 1;
+void final_state_identif(Lexer *lexer){
+    Token *token = emit_token(lexer, TOKEN_T_IDENTIFIER, lexer->current_row, SUB_T_NONE);
+    if(token != NULL){
+        lexer_register_symbol(lexer, token);
     }
-    return lexer->error;
 }
 
-
-
-void final_state_comment(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_EOL, "\n", 1, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer->current_row++;
-    lexer_start(lexer);
+void final_state_keyword(Lexer *lexer){
+    emit_token(lexer, TOKEN_T_KEYWORD, lexer->current_row, find_keyword(lexer));
 }
 
-int state_comment_start(Lexer *lexer){
-
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
+// identifiers and keywords share the DFA states, "is" is an operator
+void final_state_word(Lexer *lexer){
+    TOKEN_SUBTYPE keyword = find_keyword(lexer);
 
-    if(lexer->current_char == '/'){
-        read_next_char(lexer);
-        state_comment_reading(lexer);
-    } 
-    else if (lexer->current_char == '*'){
-        lexer->left_multiline_comment_start_sequence++;
-        read_next_char(lexer);
-        state_multiline_comment_reading(lexer);
-    } 
-    else {
+    if(keyword == SUB_T_NONE){
+        final_state_identif(lexer);
+    } else if(keyword == SUB_T_IS){
         final_state_operator(lexer);
+    } else {
+        final_state_keyword(lexer);
     }
-    return lexer->error;
 }
 
-int state_comment_reading(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '\n'){
-        final_state_comment(lexer);
-    }else {
-        state_comment_reading(lexer);
+void final_state_global_identif(Lexer *lexer){
+    Token *token = emit_token(lexer, TOKEN_T_GLOBAL_VAR, lexer->current_row, SUB_T_NONE);
+    if(token != NULL){
+        lexer_register_symbol(lexer, token);
     }
-
-    return lexer->error;
 }
 
-int state_multiline_comment_reading(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '/'){
-        state_reading_comment_start_sequence(lexer);
-    } 
-    else if(lexer->current_char == '*') {
-        state_reading_comment_end_sequence(lexer);
-    }
-    else if(lexer->current_char > 31 || (lexer->current_char != '\n' && isspace(lexer->current_char))){
-        state_multiline_comment_reading(lexer);
-    }
-    else if(lexer->left_multiline_comment_start_sequence == lexer->left_multiline_comment_end_sequence){
-        final_state_comment(lexer);
-    }
-    else if(lexer->current_char == '\n'){
-        lexer->current_row++;
-        state_multiline_comment_reading(lexer);
-    }
-    else {
-        lexer->error = 1;
+void final_state_number(Lexer *lexer){
+    Token *token = emit_token(lexer, TOKEN_T_NUM, lexer->current_row, SUB_T_NONE);
+    if(token != NULL){
+        lexer_register_literal(lexer, token);
     }
-
-    return lexer->error;
 }
 
-void state_reading_comment_start_sequence(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '*'){
-        lexer->left_multiline_comment_start_sequence++;
+// multiline strings are reported on the line they start at
+void final_state_string(Lexer *lexer){
+    Token *token = emit_token(lexer, TOKEN_T_STRING, lexer->current_row - lexer->newlines_in_multiline, SUB_T_NONE);
+    if(token != NULL){
+        lexer_register_literal(lexer, token);
     }
-    
-    state_multiline_comment_reading(lexer);
+    lexer->newlines_in_multiline = 0;
 }
 
-void state_reading_comment_end_sequence(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '/'){
-        lexer->left_multiline_comment_end_sequence++;
-    }
-    
-    state_multiline_comment_reading(lexer);
+void final_state_comment(Lexer *lexer){
+    // the token only covers the newline, not the comment before it
+    lexer->token_start = lexer->cursor - 1;
+    emit_token(lexer, TOKEN_T_EOL, lexer->current_row, SUB_T_EOL);
+    lexer->current_row++;
 }
 
-
 void final_state_operator(Lexer *lexer){
-    Token *token = create_token(TOKEN_T_OPERATOR, lexer->lexeme, lexer->lexeme_length, lexer->current_row, lexer->current_col, lexer->scope, lexer->previous_scope_arr, lexer->scope_index);
-    add_token_to_token_table(lexer, token);
-    lexer_start(lexer);
-}
-
-void state_two_char_operator(Lexer *lexer){
-    lexer->current_char = getc(stdin);
-    ungetc(lexer->current_char, stdin);
-    if(lexer->current_char == '='){
-        read_next_char(lexer);
-        final_state_operator(lexer);
-    } else {
-        final_state_operator(lexer);
-    }
-}
-
-int state_exclamation_operator(Lexer *lexer){
-    read_next_char(lexer);
-    if(lexer->current_char == '='){
-        final_state_operator(lexer);
-    } else {
-        lexer->error = 1;
-    }
-
-    return lexer->error;
+    emit_token(lexer, TOKEN_T_OPERATOR, lexer->current_row, find_punctuation(lexer));
 }
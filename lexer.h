@@ -3,94 +3,109 @@
 
 #include "token.h"
 #include "symtable.h"
+#include "source.h"
+
+// tokens the lexer can find again in streaming mode, lookahead plus one step back,
+// the tokens themselves stay in the arena because AST terminals point to them
+#define LEXER_RING_SIZE 4
+
+// kind and subtype of the tokens in parallel byte arrays indexed by token number
+// (by its place in the ring in streaming mode), the parser peeks at these instead of whole tokens
+typedef struct token_store {
+    unsigned char *kinds;       // TOKEN_TYPE
+    unsigned char *subtypes;    // TOKEN_SUBTYPE
+    int capacity;
+} Token_store;
+
+// whitespace and comments between two tokens, only kept for tooling
+typedef struct trivia {
+    size_t start;
+    size_t end;
+    int next_token;     // index of the token after it, the token count for the end of input
+} Trivia;
 
 typedef struct lexer {
     int current_col;
     int current_row;
 
-    Symtable *symtable;
+    Symtable *symtable;     // NULL for chunk lexers
+    Arena *arena;
+    Scope_tree *scopes;
+
+    Source *source;
+    size_t cursor;
+    size_t chunk_end;       // chunk lexers stop before a token starting here
+    int at_end;             // the input is over, no more tokens will come
 
     int error;
 
-    int scope;
-    int max_scope; 
-    int *previous_scope_arr;
-    int scope_index;
-    int scope_id;
+    int scope;      // id in scopes of the block the lexer is in
 
-    int lexeme_length;
-    char *lexeme;
+    // the current lexeme is the part of the source between token_start and cursor
+    size_t token_start;
     char current_char;
 
     Token *token_table;
     int token_count;
+    int token_capacity;
+    Token_store store;
 
     int token_index;
 
+    // tokens are lexed on demand by get_next_token() instead of by lexer_start()
+    int streaming;
+    Token *token_ring[LEXER_RING_SIZE];
+
     int newlines_in_multiline;
 
-    int left_multiline_comment_start_sequence;
-    int left_multiline_comment_end_sequence;
+    int multiline_comment_depth;    // opened minus closed, nested comments count too
+
+    // index of the first token of a plain newline, columns are reset there
+    // (a newline ending a comment keeps counting), -1 until there is one
+    int first_line_end;
+
+    // off unless lexer_keep_trivia() is called, the compiler doesn't need it
+    int keep_trivia;
+    size_t trivia_start;    // end of the last token
+    Trivia *trivia_table;
+    int trivia_count;
+    int trivia_capacity;
 } Lexer;
 
-Lexer *init_lexer(Symtable *symtable); 
-void extend_lexeme(Lexer *lexer, char curent_char);
+Lexer *init_lexer(Symtable *symtable, Source *source);
+Lexer *init_chunk_lexer(Arena *arena, Source *source, size_t start, size_t end);
+int peek_next_char(Lexer *lexer);
+void read_next_char(Lexer *lexer);
 int lexer_start(Lexer *lexer);
-void add_token_to_token_table(Lexer *lexer, Token *token);
+int lexer_next_token(Lexer *lexer);
+Token *add_token_to_token_table(Lexer *lexer);
+Token *emit_token(Lexer *lexer, TOKEN_TYPE token_type, int line_number, TOKEN_SUBTYPE subtype);
+char *materialize_lexeme(Lexer *lexer, Token *token);
 void print_token_table(Lexer *lexer);
+void lexer_keep_trivia(Lexer *lexer);
+void print_trivia_table(Lexer *lexer);
+
+void lexer_store_kind(Lexer *lexer, int index, Token *token);
 
 Token *get_next_token(Lexer *lexer);
 Token *get_lookahead_token(Lexer *lexer);
+int lexer_lookahead_kind(Lexer *lexer);
+TOKEN_SUBTYPE lexer_lookahead_subtype(Lexer *lexer);
+void unget_token(Lexer *lexer);
+int lexer_finish(Lexer *lexer);
 
 void final_state_end_of_line(Lexer *lexer);
 void final_state_comma(Lexer *lexer);
 void final_state_brackets(Lexer *lexer);
-
+void lexer_register_symbol(Lexer *lexer, Token *token);
+void lexer_register_literal(Lexer *lexer, Token *token);
 void final_state_identif(Lexer *lexer);
 void final_state_keyword(Lexer *lexer);
-void state_id_start(Lexer *lexer);
-void state_id_read(Lexer *lexer);
-
+void final_state_word(Lexer *lexer);
 void final_state_global_identif(Lexer *lexer);
-int state_global1(Lexer *lexer);
-int state_global2(Lexer *lexer);
-int state_global3(Lexer *lexer);
-
 void final_state_number(Lexer *lexer);
-int state_zero(Lexer *lexer);
-int state_digit(Lexer *lexer);
-int state_hex_prefix(Lexer *lexer);
-int state_hex_numba(Lexer *lexer);
-int state_dot_arrived(Lexer *lexer);
-int state_decimal_part(Lexer *lexer);
-int state_exponent_prefix(Lexer *lexer);
-int state_exponent(Lexer *lexer);
-
 void final_state_string(Lexer *lexer);
-int state_string_reading(Lexer *lexer);
-int state_special_symbol(Lexer *lexer);
-int state_string_hex_prefix(Lexer *lexer);
-int state_string_hex_number(Lexer *lexer);
-int state_multiline_string_reading(Lexer *lexer);
-int state_multiline_string1(Lexer *lexer);
-int state_multiline_string2(Lexer *lexer);
-int state_multiline_special_symbol(Lexer *lexer);
-int state_multiline_string_hex_prefix(Lexer *lexer);
-int state_multiline_string_hex_number(Lexer *lexer);
-
 void final_state_comment(Lexer *lexer);
-int state_comment_start(Lexer *lexer);
-int state_comment_reading(Lexer *lexer);
-int state_multiline_comment_reading(Lexer *lexer);
-void state_reading_comment_start_sequence(Lexer *lexer);
-void state_reading_comment_end_sequence(Lexer *lexer);
-
-
 void final_state_operator(Lexer *lexer);
-void state_two_char_operator(Lexer *lexer);
-int state_exclamation_operator(Lexer *lexer);
-
-
-int* extend_array(int *int_arr, int number_of_elements, int value_to_add, int index);
 
 #endif
\ No newline at end of file
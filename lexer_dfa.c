@@ -0,0 +1,255 @@
+#include <stddef.h>
+#include "lexer_dfa.h"
+
+#define CLASS(c) (1u << (c))
+
+// groups of character classes used by the token specification
+#define CLASSES_DIGIT       (CLASS(CHAR_C_ZERO) | CLASS(CHAR_C_DIGIT))
+#define CLASSES_HEX_DIGIT   (CLASSES_DIGIT | CLASS(CHAR_C_E) | CLASS(CHAR_C_HEX_LETTER))
+#define CLASSES_LETTER      (CLASS(CHAR_C_E) | CLASS(CHAR_C_X) | CLASS(CHAR_C_HEX_LETTER) | CLASS(CHAR_C_LETTER))
+#define CLASSES_IDENTIF     (CLASSES_LETTER | CLASSES_DIGIT | CLASS(CHAR_C_UNDERSCORE))
+#define CLASSES_SPACE       (CLASS(CHAR_C_BLANK) | CLASS(CHAR_C_SPACE))
+// everything above 31 (DEL included) but the quote
+#define CLASSES_PRINTABLE   (CLASS(CHAR_C_OTHER) | CLASS(CHAR_C_BLANK) | CLASSES_IDENTIF | \
+                             CLASS(CHAR_C_SLASH) | CLASS(CHAR_C_STAR) | CLASS(CHAR_C_DOT) | \
+                             CLASS(CHAR_C_COMMA) | CLASS(CHAR_C_BRACKET) | CLASS(CHAR_C_PLUS_MINUS) | \
+                             CLASS(CHAR_C_RELATIONAL) | CLASS(CHAR_C_EQUALS) | CLASS(CHAR_C_EXCLAMATION))
+#define CLASSES_ANY         ((1u << CHAR_C_COUNT) - 1)
+
+Lexer_dfa lexer_dfa;
+
+typedef struct {
+    CHAR_CLASS char_class;
+    const char *chars;
+} Char_class_spec;
+
+typedef struct {
+    LEXER_STATE from;
+    unsigned classes;
+    LEXER_STATE to;
+} Transition_spec;
+
+typedef struct {
+    LEXER_STATE state;
+    LEXER_ACCEPT accept;
+    LEXER_ACTION action;
+} State_spec;
+
+typedef struct {
+    LEXER_STATE state;
+    Lexer_run run;
+} Run_spec;
+
+// later entries override earlier ones, letters are refined after the whole alphabet
+static const Char_class_spec char_class_spec[] = {
+    {CHAR_C_NEWLINE,     "\n"},
+    {CHAR_C_BLANK,       " "},
+    {CHAR_C_SPACE,       "\t\v\f\r"},
+    {CHAR_C_LETTER,      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"},
+    {CHAR_C_HEX_LETTER,  "abcdfABCDF"},
+    {CHAR_C_E,           "eE"},
+    {CHAR_C_X,           "x"},
+    {CHAR_C_ZERO,        "0"},
+    {CHAR_C_DIGIT,       "123456789"},
+    {CHAR_C_UNDERSCORE,  "_"},
+    {CHAR_C_QUOTE,       "\""},
+    {CHAR_C_SLASH,       "/"},
+    {CHAR_C_STAR,        "*"},
+    {CHAR_C_DOT,         "."},
+    {CHAR_C_COMMA,       ","},
+    {CHAR_C_BRACKET,     "(){}"},
+    {CHAR_C_PLUS_MINUS,  "+-"},
+    {CHAR_C_RELATIONAL,  "<>"},
+    {CHAR_C_EQUALS,      "="},
+    {CHAR_C_EXCLAMATION, "!"},
+};
+
+// the IFJ25 token grammar, later entries for the same state override earlier ones
+static const Transition_spec transition_spec[] = {
+    // whitespace before a token is skipped, anything unlisted is an error
+    {LEX_S_START, CLASSES_SPACE,                   LEX_S_START},
+    {LEX_S_START, CLASS(CHAR_C_EOF),               LEX_S_END},
+    {LEX_S_START, CLASS(CHAR_C_NEWLINE),           LEX_S_EOL},
+    {LEX_S_START, CLASS(CHAR_C_COMMA),             LEX_S_COMMA},
+    {LEX_S_START, CLASS(CHAR_C_BRACKET),           LEX_S_BRACKET},
+    {LEX_S_START, CLASS(CHAR_C_PLUS_MINUS) | CLASS(CHAR_C_STAR) | CLASS(CHAR_C_DOT), LEX_S_OPERATOR},
+    {LEX_S_START, CLASS(CHAR_C_RELATIONAL) | CLASS(CHAR_C_EQUALS), LEX_S_RELATIONAL},
+    {LEX_S_START, CLASS(CHAR_C_EXCLAMATION),       LEX_S_EXCLAMATION},
+    {LEX_S_START, CLASS(CHAR_C_SLASH),             LEX_S_SLASH},
+    {LEX_S_START, CLASSES_LETTER,                  LEX_S_IDENTIF},
+    {LEX_S_START, CLASS(CHAR_C_UNDERSCORE),        LEX_S_GLOBAL1},
+    {LEX_S_START, CLASS(CHAR_C_ZERO),              LEX_S_ZERO},
+    {LEX_S_START, CLASS(CHAR_C_DIGIT),             LEX_S_INT},
+    {LEX_S_START, CLASS(CHAR_C_QUOTE),             LEX_S_STRING_OPEN},
+
+    // <= >= == !=
+    {LEX_S_RELATIONAL,  CLASS(CHAR_C_EQUALS),      LEX_S_OPERATOR},
+    {LEX_S_EXCLAMATION, CLASS(CHAR_C_EQUALS),      LEX_S_OPERATOR},
+
+    // identifiers and __globals
+    {LEX_S_IDENTIF, CLASSES_IDENTIF,               LEX_S_IDENTIF},
+    {LEX_S_GLOBAL1, CLASS(CHAR_C_UNDERSCORE),      LEX_S_GLOBAL2},
+    {LEX_S_GLOBAL2, CLASSES_IDENTIF,               LEX_S_GLOBAL},
+    {LEX_S_GLOBAL,  CLASSES_IDENTIF,               LEX_S_GLOBAL},
+
+    // 0, 0x1F, 12, 1.5, 1e10, 1.5E3, exponents have no sign
+    {LEX_S_ZERO,            CLASSES_DIGIT,         LEX_S_INT},
+    {LEX_S_ZERO,            CLASS(CHAR_C_X),       LEX_S_HEX_PREFIX},
+    {LEX_S_ZERO,            CLASS(CHAR_C_DOT),     LEX_S_DOT},
+    {LEX_S_INT,             CLASSES_DIGIT,         LEX_S_INT},
+    {LEX_S_INT,             CLASS(CHAR_C_DOT),     LEX_S_DOT},
+    {LEX_S_INT,             CLASS(CHAR_C_E),       LEX_S_EXPONENT_PREFIX},
+    {LEX_S_HEX_PREFIX,      CLASSES_HEX_DIGIT,     LEX_S_HEX},
+    {LEX_S_HEX,             CLASSES_HEX_DIGIT,     LEX_S_HEX},
+    {LEX_S_DOT,             CLASSES_DIGIT,         LEX_S_DECIMAL},
+    {LEX_S_DECIMAL,         CLASSES_DIGIT,         LEX_S_DECIMAL},
+    {LEX_S_DECIMAL,         CLASS(CHAR_C_E),       LEX_S_EXPONENT_PREFIX},
+    {LEX_S_EXPONENT_PREFIX, CLASSES_DIGIT,         LEX_S_EXPONENT},
+    {LEX_S_EXPONENT,        CLASSES_DIGIT,         LEX_S_EXPONENT},
+
+    // "..." on one line, "" directly followed by " opens a """multiline""" string
+    {LEX_S_STRING_OPEN,  CLASSES_PRINTABLE,        LEX_S_STRING},
+    {LEX_S_STRING_OPEN,  CLASS(CHAR_C_QUOTE),      LEX_S_STRING_EMPTY},
+    {LEX_S_STRING,       CLASSES_PRINTABLE,        LEX_S_STRING},
+    {LEX_S_STRING,       CLASS(CHAR_C_QUOTE),      LEX_S_STRING_END},
+    {LEX_S_STRING_EMPTY, CLASS(CHAR_C_QUOTE),      LEX_S_MULTILINE_STRING},
+
+    {LEX_S_MULTILINE_STRING, CLASSES_PRINTABLE | CLASS(CHAR_C_SPACE), LEX_S_MULTILINE_STRING},
+    {LEX_S_MULTILINE_STRING, CLASS(CHAR_C_NEWLINE), LEX_S_MULTILINE_STRING_NEWLINE},
+    {LEX_S_MULTILINE_STRING, CLASS(CHAR_C_QUOTE),   LEX_S_MULTILINE_STRING_QUOTE1},
+    {LEX_S_MULTILINE_STRING_QUOTE1, CLASS(CHAR_C_QUOTE), LEX_S_MULTILINE_STRING_QUOTE2},
+    {LEX_S_MULTILINE_STRING_QUOTE2, CLASS(CHAR_C_QUOTE), LEX_S_MULTILINE_STRING_END},
+
+    // / and // comments
+    {LEX_S_SLASH,   CLASS(CHAR_C_SLASH),           LEX_S_COMMENT},
+    {LEX_S_SLASH,   CLASS(CHAR_C_STAR),            LEX_S_MULTILINE_COMMENT_OPEN},
+    {LEX_S_COMMENT, CLASSES_ANY,                   LEX_S_COMMENT},
+    {LEX_S_COMMENT, CLASS(CHAR_C_NEWLINE) | CLASS(CHAR_C_EOF), LEX_S_COMMENT_END},
+
+    // /* nested */ comments run until the first newline after they are balanced,
+    // the character after a '/' or '*' is consumed without being looked at again
+    {LEX_S_MULTILINE_COMMENT, CLASSES_ANY,         LEX_S_MULTILINE_COMMENT_CONTROL},
+    {LEX_S_MULTILINE_COMMENT, CLASSES_PRINTABLE | CLASS(CHAR_C_SPACE) | CLASS(CHAR_C_QUOTE), LEX_S_MULTILINE_COMMENT},
+    {LEX_S_MULTILINE_COMMENT, CLASS(CHAR_C_NEWLINE), LEX_S_MULTILINE_COMMENT_NEWLINE},
+    {LEX_S_MULTILINE_COMMENT, CLASS(CHAR_C_SLASH), LEX_S_MULTILINE_COMMENT_SLASH},
+    {LEX_S_MULTILINE_COMMENT, CLASS(CHAR_C_STAR),  LEX_S_MULTILINE_COMMENT_STAR},
+    {LEX_S_MULTILINE_COMMENT_SLASH, CLASSES_ANY,        LEX_S_MULTILINE_COMMENT},
+    {LEX_S_MULTILINE_COMMENT_SLASH, CLASS(CHAR_C_STAR), LEX_S_MULTILINE_COMMENT_OPEN},
+    {LEX_S_MULTILINE_COMMENT_STAR,  CLASSES_ANY,         LEX_S_MULTILINE_COMMENT},
+    {LEX_S_MULTILINE_COMMENT_STAR,  CLASS(CHAR_C_SLASH), LEX_S_MULTILINE_COMMENT_CLOSE},
+};
+
+// states that continue exactly like another state once their action is done
+static const LEXER_STATE alias_spec[][2] = {
+    {LEX_S_MULTILINE_STRING_NEWLINE,  LEX_S_MULTILINE_STRING},
+    {LEX_S_MULTILINE_COMMENT_OPEN,    LEX_S_MULTILINE_COMMENT},
+    {LEX_S_MULTILINE_COMMENT_CLOSE,   LEX_S_MULTILINE_COMMENT},
+    {LEX_S_MULTILINE_COMMENT_NEWLINE, LEX_S_MULTILINE_COMMENT},
+};
+
+static const State_spec state_spec[] = {
+    {LEX_S_END,                       LEX_ACCEPT_NONE,     LEX_ACTION_END},
+    {LEX_S_EOL,                       LEX_ACCEPT_EOL,      LEX_ACTION_NONE},
+    {LEX_S_COMMA,                     LEX_ACCEPT_COMMA,    LEX_ACTION_NONE},
+    {LEX_S_BRACKET,                   LEX_ACCEPT_BRACKET,  LEX_ACTION_NONE},
+    {LEX_S_OPERATOR,                  LEX_ACCEPT_OPERATOR, LEX_ACTION_NONE},
+    {LEX_S_RELATIONAL,                LEX_ACCEPT_OPERATOR, LEX_ACTION_NONE},
+    {LEX_S_SLASH,                     LEX_ACCEPT_OPERATOR, LEX_ACTION_NONE},
+    {LEX_S_IDENTIF,                   LEX_ACCEPT_WORD,     LEX_ACTION_NONE},
+    {LEX_S_GLOBAL,                    LEX_ACCEPT_GLOBAL,   LEX_ACTION_NONE},
+    {LEX_S_ZERO,                      LEX_ACCEPT_NUMBER,   LEX_ACTION_NONE},
+    {LEX_S_INT,                       LEX_ACCEPT_NUMBER,   LEX_ACTION_NONE},
+    {LEX_S_HEX,                       LEX_ACCEPT_NUMBER,   LEX_ACTION_NONE},
+    {LEX_S_DECIMAL,                   LEX_ACCEPT_NUMBER,   LEX_ACTION_NONE},
+    {LEX_S_EXPONENT,                  LEX_ACCEPT_NUMBER,   LEX_ACTION_NONE},
+    {LEX_S_STRING_EMPTY,              LEX_ACCEPT_STRING,   LEX_ACTION_NONE},
+    {LEX_S_STRING_END,                LEX_ACCEPT_STRING,   LEX_ACTION_NONE},
+    {LEX_S_MULTILINE_STRING_END,      LEX_ACCEPT_STRING,   LEX_ACTION_NONE},
+    {LEX_S_MULTILINE_STRING_NEWLINE,  LEX_ACCEPT_NONE,     LEX_ACTION_STRING_NEWLINE},
+    {LEX_S_COMMENT_END,               LEX_ACCEPT_NONE,     LEX_ACTION_COMMENT_END},
+    {LEX_S_MULTILINE_COMMENT_OPEN,    LEX_ACCEPT_NONE,     LEX_ACTION_COMMENT_OPEN},
+    {LEX_S_MULTILINE_COMMENT_CLOSE,   LEX_ACCEPT_NONE,     LEX_ACTION_COMMENT_CLOSE},
+    {LEX_S_MULTILINE_COMMENT_NEWLINE, LEX_ACCEPT_NONE,     LEX_ACTION_COMMENT_NEWLINE},
+    {LEX_S_MULTILINE_COMMENT_CONTROL, LEX_ACCEPT_NONE,     LEX_ACTION_COMMENT_CONTROL},
+};
+
+// states that loop over long runs of bytes, those are skipped by lexer_scan_run()
+// '{' and '}' always end a run because reading them changes the scope
+static const Run_spec run_spec[] = {
+    {LEX_S_START,             {" \t",        1, 0}},
+    {LEX_S_STRING,            {"\"{}",       0, 1}},
+    {LEX_S_MULTILINE_STRING,  {"\"{}",       0, 1}},
+    {LEX_S_COMMENT,           {"\n{}",      0, 0}},
+    {LEX_S_MULTILINE_COMMENT, {"/*{}",       0, 1}},
+};
+
+#define SPEC_LENGTH(spec) (sizeof(spec) / sizeof(spec[0]))
+
+static int lexer_dfa_built = 0;
+
+// a run may only cover bytes that keep the DFA in its state without any side effect
+static int run_agrees_with_table(const Run_spec *spec){
+    for(int c = 0; c < 256; c++){
+        if(lexer_run_stops_at(&spec->run, c)){
+            continue;
+        }
+        if(c == '{' || c == '}' || lexer_dfa.actions[spec->state] != LEX_ACTION_NONE ||
+           lexer_dfa.transitions[spec->state][lexer_dfa.char_classes[c]] != spec->state){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// compiles the specification above into the dense tables, only the first call does anything
+void lexer_dfa_build(){
+    if(lexer_dfa_built){
+        return;
+    }
+
+    // bytes the specification doesn't mention, the end of input has a class of its own
+    for(int c = 0; c < 256; c++){
+        if(c < 32){
+            lexer_dfa.char_classes[c] = CHAR_C_CONTROL;
+        } else if(c < 128){
+            lexer_dfa.char_classes[c] = CHAR_C_OTHER;
+        } else {
+            lexer_dfa.char_classes[c] = CHAR_C_HIGH;
+        }
+    }
+
+    for(unsigned i = 0; i < SPEC_LENGTH(char_class_spec); i++){
+        for(const char *c = char_class_spec[i].chars; *c != '\0'; c++){
+            lexer_dfa.char_classes[(unsigned char)*c] = char_class_spec[i].char_class;
+        }
+    }
+
+    for(unsigned i = 0; i < SPEC_LENGTH(transition_spec); i++){
+        const Transition_spec *spec = &transition_spec[i];
+        for(int char_class = 0; char_class < CHAR_C_COUNT; char_class++){
+            if(spec->classes & CLASS(char_class)){
+                lexer_dfa.transitions[spec->from][char_class] = spec->to;
+            }
+        }
+    }
+
+    for(unsigned i = 0; i < SPEC_LENGTH(alias_spec); i++){
+        for(int char_class = 0; char_class < CHAR_C_COUNT; char_class++){
+            lexer_dfa.transitions[alias_spec[i][0]][char_class] = lexer_dfa.transitions[alias_spec[i][1]][char_class];
+        }
+    }
+
+    for(unsigned i = 0; i < SPEC_LENGTH(state_spec); i++){
+        lexer_dfa.accepts[state_spec[i].state] = state_spec[i].accept;
+        lexer_dfa.actions[state_spec[i].state] = state_spec[i].action;
+    }
+
+    for(unsigned i = 0; i < SPEC_LENGTH(run_spec); i++){
+        if(run_agrees_with_table(&run_spec[i])){
+            lexer_dfa.runs[run_spec[i].state] = &run_spec[i].run;
+        }
+    }
+    lexer_scan_init();
+
+    lexer_dfa_built = 1;
+}
@@ -0,0 +1,128 @@
+#ifndef LEXER_DFA_H
+#define LEXER_DFA_H
+
+#include <stdio.h>
+#include "lexer_scan.h"
+
+// character classes, every byte of the source falls into exactly one
+typedef enum {
+    CHAR_C_OTHER,       // printable characters with no meaning of their own
+    CHAR_C_EOF,         // end of input, no byte has this class
+    CHAR_C_NEWLINE,
+    CHAR_C_BLANK,       // ' '
+    CHAR_C_SPACE,       // \t \v \f \r
+    CHAR_C_CONTROL,     // the rest of 0-31
+    CHAR_C_HIGH,        // 128-255
+    CHAR_C_ZERO,
+    CHAR_C_DIGIT,       // 1-9
+    CHAR_C_E,           // e E, hex digit and exponent
+    CHAR_C_X,           // x, hex prefix
+    CHAR_C_HEX_LETTER,  // a-f A-F except e E
+    CHAR_C_LETTER,
+    CHAR_C_UNDERSCORE,
+    CHAR_C_QUOTE,
+    CHAR_C_SLASH,
+    CHAR_C_STAR,
+    CHAR_C_DOT,
+    CHAR_C_COMMA,
+    CHAR_C_BRACKET,     // ( ) { }
+    CHAR_C_PLUS_MINUS,
+    CHAR_C_RELATIONAL,  // < >
+    CHAR_C_EQUALS,
+    CHAR_C_EXCLAMATION,
+    CHAR_C_COUNT
+} CHAR_CLASS;
+
+typedef enum {
+    LEX_S_NONE,         // no transition, the lexeme ends before the character
+    LEX_S_START,
+    LEX_S_END,
+
+    LEX_S_EOL,
+    LEX_S_COMMA,
+    LEX_S_BRACKET,
+    LEX_S_OPERATOR,
+    LEX_S_RELATIONAL,
+    LEX_S_EXCLAMATION,
+
+    LEX_S_IDENTIF,
+    LEX_S_GLOBAL1,
+    LEX_S_GLOBAL2,
+    LEX_S_GLOBAL,
+
+    LEX_S_ZERO,
+    LEX_S_INT,
+    LEX_S_HEX_PREFIX,
+    LEX_S_HEX,
+    LEX_S_DOT,
+    LEX_S_DECIMAL,
+    LEX_S_EXPONENT_PREFIX,
+    LEX_S_EXPONENT,
+
+    LEX_S_STRING_OPEN,
+    LEX_S_STRING,
+    LEX_S_STRING_EMPTY,
+    LEX_S_STRING_END,
+    LEX_S_MULTILINE_STRING,
+    LEX_S_MULTILINE_STRING_NEWLINE,
+    LEX_S_MULTILINE_STRING_QUOTE1,
+    LEX_S_MULTILINE_STRING_QUOTE2,
+    LEX_S_MULTILINE_STRING_END,
+
+    LEX_S_SLASH,
+    LEX_S_COMMENT,
+    LEX_S_COMMENT_END,
+    LEX_S_MULTILINE_COMMENT,
+    LEX_S_MULTILINE_COMMENT_SLASH,
+    LEX_S_MULTILINE_COMMENT_STAR,
+    LEX_S_MULTILINE_COMMENT_OPEN,
+    LEX_S_MULTILINE_COMMENT_CLOSE,
+    LEX_S_MULTILINE_COMMENT_NEWLINE,
+    LEX_S_MULTILINE_COMMENT_CONTROL,
+    LEX_S_COUNT
+} LEXER_STATE;
+
+// what happens when the lexeme can't go on from a state
+typedef enum {
+    LEX_ACCEPT_NONE,    // lexical error
+    LEX_ACCEPT_EOL,
+    LEX_ACCEPT_COMMA,
+    LEX_ACCEPT_BRACKET,
+    LEX_ACCEPT_OPERATOR,
+    LEX_ACCEPT_WORD,    // identifier, keyword or "is"
+    LEX_ACCEPT_GLOBAL,
+    LEX_ACCEPT_NUMBER,
+    LEX_ACCEPT_STRING
+} LEXER_ACCEPT;
+
+// what the lexer does right after entering a state,
+// covers what the table can't count (lines, comment nesting)
+typedef enum {
+    LEX_ACTION_NONE,
+    LEX_ACTION_END,             // end of input, no more tokens
+    LEX_ACTION_STRING_NEWLINE,
+    LEX_ACTION_COMMENT_OPEN,
+    LEX_ACTION_COMMENT_CLOSE,
+    LEX_ACTION_COMMENT_END,     // line comment is over
+    LEX_ACTION_COMMENT_NEWLINE, // ends a balanced multiline comment
+    LEX_ACTION_COMMENT_CONTROL  // ends a balanced multiline comment, error otherwise
+} LEXER_ACTION;
+
+typedef struct lexer_dfa {
+    unsigned char char_classes[256];
+    unsigned char transitions[LEX_S_COUNT][CHAR_C_COUNT];
+    unsigned char accepts[LEX_S_COUNT];
+    unsigned char actions[LEX_S_COUNT];
+    const Lexer_run *runs[LEX_S_COUNT];     // NULL if the state has no fast path
+} Lexer_dfa;
+
+extern Lexer_dfa lexer_dfa;
+
+void lexer_dfa_build();
+
+// c is a byte as an unsigned char or EOF
+static inline CHAR_CLASS lexer_char_class(int c){
+    return c == EOF ? CHAR_C_EOF : lexer_dfa.char_classes[c];
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "lexer_parallel.h"
+#include "utils.h"
+
+// a part of the source that starts right after a newline
+typedef struct lexer_chunk {
+    size_t start;
+    size_t end;
+    Arena *arena;
+    Lexer *lexer;
+    pthread_t thread;
+    int has_thread;
+} Lexer_chunk;
+
+// lexes tokens until the next one would start in the following chunk
+static void lex_chunk(Lexer *lexer){
+    while(lexer->cursor < lexer->chunk_end && lexer_next_token(lexer)){
+    }
+}
+
+static void *chunk_worker(void *chunk){
+    lex_chunk(((Lexer_chunk *)chunk)->lexer);
+    return NULL;
+}
+
+static int chunk_count_for(Source *source){
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    long count = source->length / LEXER_CHUNK_MIN_SIZE;
+
+    if(cpus < count){
+        count = cpus;
+    }
+    if(count > LEXER_MAX_CHUNKS){
+        count = LEXER_MAX_CHUNKS;
+    }
+    return count < 1 ? 1 : count;
+}
+
+// cuts the source into about wanted pieces of the same size, every cut is just after a newline
+static int split_source(Source *source, Lexer_chunk *chunks, int wanted){
+    int count = 0;
+    size_t start = 0;
+
+    for(int i = 1; i < wanted; i++){
+        size_t target = source->length / wanted * i;
+        if(target < start){
+            target = start;
+        }
+
+        char *newline = memchr(source->buffer + target, '\n', source->length - target);
+        if(newline == NULL){
+            break;
+        }
+
+        size_t end = newline - source->buffer + 1;
+        if(end >= source->length){
+            break;
+        }
+        chunks[count].start = start;
+        chunks[count].end = end;
+        count++;
+        start = end;
+    }
+
+    chunks[count].start = start;
+    chunks[count].end = source->length;
+
+    return count + 1;
+}
+
+// maps a scope of a chunk to the global scope tree, start_scope is where the chunk started
+static int resolve_scope(Lexer *lexer, int *scope_ids, int start_scope, int scope){
+    if(scope > SCOPE_ROOT){
+        return scope_ids[scope - SCOPE_ID_OFFSET];
+    }
+
+    // the chunk closed scopes it didn't open, those enclose start_scope
+    for(; scope < SCOPE_ROOT; scope++){
+        start_scope = scope_parent(lexer->scopes, start_scope);
+    }
+    return start_scope;
+}
+
+// appends the tokens of a chunk lexed from the same position the lexer is at now
+// lines, columns and scopes were counted from the start of the chunk, so they are rebased,
+// identifiers get into the symtable in the same order as if the lexer read them itself
+static void splice_chunk(Lexer *lexer, Lexer *chunk){
+    int row_offset = lexer->current_row - 1;
+    int col_offset = lexer->current_col - 1;
+    int start_scope = lexer->scope;
+
+    // scopes opened in the chunk get their global ids in the order they were opened
+    Scope_tree *chunk_scopes = chunk->scopes;
+    int *scope_ids = arena_alloc(chunk->arena, sizeof(int) * chunk_scopes->count);
+    if(scope_ids == NULL){
+        lexer->error = ERR_T_MALLOC_ERR;
+        return;
+    }
+    for(int i = 1; i < chunk_scopes->count; i++){
+        int parent = resolve_scope(lexer, scope_ids, start_scope, chunk_scopes->parents[i]);
+        scope_ids[i] = scope_open(lexer->scopes, parent);
+        if(scope_ids[i] < 0){
+            lexer->error = ERR_T_MALLOC_ERR;
+            return;
+        }
+    }
+
+    for(int i = 0; i < chunk->token_count; i++){
+        Token *token = add_token_to_token_table(lexer);
+        if(token == NULL){
+            lexer->error = ERR_T_MALLOC_ERR;
+            return;
+        }
+
+        *token = chunk->token_table[i];
+        token->token_line_number += row_offset;
+        // columns go on from the previous chunk until the first plain newline
+        if(chunk->first_line_end < 0 || i < chunk->first_line_end){
+            token->token_col_number += col_offset;
+        }
+        token->scope = resolve_scope(lexer, scope_ids, start_scope, token->scope);
+        lexer_store_kind(lexer, lexer->token_count - 1, token);
+
+        if(token->token_type == TOKEN_T_IDENTIFIER || token->token_type == TOKEN_T_GLOBAL_VAR){
+            lexer_register_symbol(lexer, token);
+        } else if(token->token_type == TOKEN_T_NUM || token->token_type == TOKEN_T_STRING){
+            lexer_register_literal(lexer, token);
+        }
+    }
+
+    lexer->cursor = chunk->cursor;
+    lexer->current_row = chunk->current_row + row_offset;
+    if(chunk->first_line_end < 0){
+        lexer->current_col = chunk->current_col + col_offset;
+    } else {
+        lexer->current_col = chunk->current_col;
+    }
+    lexer->scope = resolve_scope(lexer, scope_ids, start_scope, chunk->scope);
+    lexer->newlines_in_multiline = chunk->newlines_in_multiline;
+    lexer->multiline_comment_depth = chunk->multiline_comment_depth;
+    lexer->at_end = chunk->at_end;
+    lexer->error = chunk->error;
+}
+
+// lexes the source split into chunks, the first one on this thread and the others on worker threads
+// each worker guesses its chunk starts between two tokens, chunks that start inside a multiline
+// string or comment are thrown away and lexed again here once the previous chunk is done,
+// the tokens and the symtable end up the same as with lexer_next_token() in a loop
+int lexer_start_parallel(Lexer *lexer){
+    Lexer_chunk chunks[LEXER_MAX_CHUNKS];
+    int chunk_count = split_source(lexer->source, chunks, chunk_count_for(lexer->source));
+
+    for(int i = 1; i < chunk_count; i++){
+        chunks[i].has_thread = 0;
+        chunks[i].lexer = NULL;
+        chunks[i].arena = arena_create();
+        if(chunks[i].arena != NULL){
+            chunks[i].lexer = init_chunk_lexer(chunks[i].arena, lexer->source, chunks[i].start, chunks[i].end);
+        }
+        if(chunks[i].lexer != NULL){
+            chunks[i].has_thread = pthread_create(&chunks[i].thread, NULL, chunk_worker, &chunks[i]) == 0;
+        }
+    }
+
+    lexer->chunk_end = chunks[0].end;
+    lex_chunk(lexer);
+
+    for(int i = 1; i < chunk_count; i++){
+        if(chunks[i].has_thread){
+            pthread_join(chunks[i].thread, NULL);
+        }
+
+        if(lexer->error == 0 && !lexer->at_end){
+            if(chunks[i].has_thread && lexer->cursor == chunks[i].start){
+                splice_chunk(lexer, chunks[i].lexer);
+            } else {
+                lexer->chunk_end = chunks[i].end;
+                lex_chunk(lexer);
+            }
+        }
+
+        arena_destroy(chunks[i].arena);
+    }
+
+    // whatever is left (trailing whitespace) is lexed as usual
+    lexer->chunk_end = lexer->source->length;
+    while(lexer->error == 0 && !lexer->at_end && lexer_next_token(lexer)){
+    }
+
+    return lexer->error;
+}
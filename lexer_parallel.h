@@ -0,0 +1,20 @@
+#ifndef LEXER_PARALLEL_H
+#define LEXER_PARALLEL_H
+
+#include "lexer.h"
+
+// sources smaller than this are lexed on one thread
+#ifndef LEXER_PARALLEL_MIN_SIZE
+#define LEXER_PARALLEL_MIN_SIZE (4 * 1024 * 1024)
+#endif
+
+// no chunk is smaller than this, so every thread gets enough work
+#ifndef LEXER_CHUNK_MIN_SIZE
+#define LEXER_CHUNK_MIN_SIZE (1024 * 1024)
+#endif
+
+#define LEXER_MAX_CHUNKS 64
+
+int lexer_start_parallel(Lexer *lexer);
+
+#endif
@@ -0,0 +1,112 @@
+#include <string.h>
+#include "lexer_scan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LEXER_SCAN_X86
+#include <immintrin.h>
+#endif
+
+typedef size_t (*Scan_function)(const Lexer_run *run, const unsigned char *buffer, size_t from, size_t length);
+
+int lexer_run_stops_at(const Lexer_run *run, unsigned char c){
+    int listed = c != '\0' && strchr(run->chars, c) != NULL;
+    if(run->continues){
+        return !listed;
+    }
+    return listed || (run->stop_below_space && (signed char)c < ' ');
+}
+
+static size_t scan_scalar(const Lexer_run *run, const unsigned char *buffer, size_t from, size_t length){
+    while(from < length && !lexer_run_stops_at(run, buffer[from])){
+        from++;
+    }
+    return from;
+}
+
+#ifdef LEXER_SCAN_X86
+
+// 16 bytes at a time, SSE2 is always there on x86-64
+__attribute__((target("sse2")))
+static size_t scan_sse2(const Lexer_run *run, const unsigned char *buffer, size_t from, size_t length){
+    int char_count = strlen(run->chars);
+    __m128i chars[LEXER_RUN_MAX_CHARS];
+    for(int i = 0; i < char_count; i++){
+        chars[i] = _mm_set1_epi8(run->chars[i]);
+    }
+    const __m128i space = _mm_set1_epi8(' ');
+
+    for(; from + 16 <= length; from += 16){
+        __m128i block = _mm_loadu_si128((const __m128i *)(buffer + from));
+        __m128i listed = _mm_setzero_si128();
+        for(int i = 0; i < char_count; i++){
+            listed = _mm_or_si128(listed, _mm_cmpeq_epi8(block, chars[i]));
+        }
+
+        int mask = _mm_movemask_epi8(listed);
+        if(run->continues){
+            mask = ~mask & 0xFFFF;
+        } else if(run->stop_below_space){
+            // signed compare, so bytes above 127 count as below the space too
+            mask |= _mm_movemask_epi8(_mm_cmplt_epi8(block, space));
+        }
+
+        if(mask != 0){
+            return from + __builtin_ctz(mask);
+        }
+    }
+
+    return scan_scalar(run, buffer, from, length);
+}
+
+// 32 bytes at a time, picked at runtime when the CPU has AVX2
+__attribute__((target("avx2")))
+static size_t scan_avx2(const Lexer_run *run, const unsigned char *buffer, size_t from, size_t length){
+    int char_count = strlen(run->chars);
+    __m256i chars[LEXER_RUN_MAX_CHARS];
+    for(int i = 0; i < char_count; i++){
+        chars[i] = _mm256_set1_epi8(run->chars[i]);
+    }
+    const __m256i space = _mm256_set1_epi8(' ');
+
+    for(; from + 32 <= length; from += 32){
+        __m256i block = _mm256_loadu_si256((const __m256i *)(buffer + from));
+        __m256i listed = _mm256_setzero_si256();
+        for(int i = 0; i < char_count; i++){
+            listed = _mm256_or_si256(listed, _mm256_cmpeq_epi8(block, chars[i]));
+        }
+
+        unsigned mask = _mm256_movemask_epi8(listed);
+        if(run->continues){
+            mask = ~mask;
+        } else if(run->stop_below_space){
+            mask |= _mm256_movemask_epi8(_mm256_cmpgt_epi8(space, block));
+        }
+
+        if(mask != 0){
+            return from + __builtin_ctz(mask);
+        }
+    }
+
+    return scan_sse2(run, buffer, from, length);
+}
+
+#endif
+
+static Scan_function scan_function = scan_scalar;
+
+// picks the widest scanner the CPU supports
+void lexer_scan_init(){
+#ifdef LEXER_SCAN_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        scan_function = scan_avx2;
+    } else if(__builtin_cpu_supports("sse2")){
+        scan_function = scan_sse2;
+    }
+#endif
+}
+
+// returns the index of the first byte from `from` on that ends the run, length if none does
+size_t lexer_scan_run(const Lexer_run *run, const char *buffer, size_t from, size_t length){
+    return scan_function(run, (const unsigned char *)buffer, from, length);
+}
@@ -0,0 +1,20 @@
+#ifndef LEXER_SCAN_H
+#define LEXER_SCAN_H
+
+#include <stddef.h>
+
+// a run of bytes the lexer can skip without looking at them one by one,
+// it ends at the first byte that may need the transition table
+typedef struct lexer_run {
+    const char *chars;      // up to LEXER_RUN_MAX_CHARS bytes
+    int continues;          // 1: the run is made of chars, 0: chars end it
+    int stop_below_space;   // bytes under ' ' and above 127 end it too
+} Lexer_run;
+
+#define LEXER_RUN_MAX_CHARS 4
+
+void lexer_scan_init();
+size_t lexer_scan_run(const Lexer_run *run, const char *buffer, size_t from, size_t length);
+int lexer_run_stops_at(const Lexer_run *run, unsigned char c);
+
+#endif
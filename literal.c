@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include "literal.h"
+
+Literal_table *init_literal_table(Arena *arena){
+    Literal_table *table = arena_alloc(arena, sizeof(Literal_table));
+    if(table == NULL){
+        return NULL;
+    }
+
+    table->arena = arena;
+    table->spellings = init_intern_table(arena);
+    table->capacity = 64;
+    table->literals = arena_alloc(arena, sizeof(Literal) * table->capacity);
+    if(table->spellings == NULL || table->literals == NULL){
+        return NULL;
+    }
+
+    return table;
+}
+
+// the spelling is already checked by the lexer, so digits are all there is to read
+// integers that fit into 64 bits are summed up exactly, the rest goes through strtod
+static double decode_number(const char *spelling, int length, int *is_integer){
+    int is_hex = length > 1 && spelling[1] == 'x';
+    *is_integer = is_hex || (memchr(spelling, '.', length) == NULL &&
+        memchr(spelling, 'e', length) == NULL && memchr(spelling, 'E', length) == NULL);
+
+    if(*is_integer){
+        int base = is_hex ? 16 : 10;
+        uint64_t value = 0;
+        int i = is_hex ? 2 : 0;
+        for(; i < length; i++){
+            char c = spelling[i];
+            int digit = c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+            if(value > (UINT64_MAX - digit) / base){
+                break;
+            }
+            value = value * base + digit;
+        }
+        if(i == length){
+            return (double)value;
+        }
+    }
+
+    // strtod needs the spelling on its own, the source goes on after it
+    char buffer[64];
+    char *copy = buffer;
+    if(length >= (int)sizeof(buffer)){
+        copy = malloc(length + 1);
+        if(copy == NULL){
+            return 0;
+        }
+    }
+    memcpy(copy, spelling, length);
+    copy[length] = '\0';
+
+    double value = strtod(copy, NULL);
+
+    if(copy != buffer){
+        free(copy);
+    }
+    return value;
+}
+
+// makes sure there's a Literal for every id handed out so far
+static Literal *reserve_literal(Literal_table *table, int id){
+    if(id >= table->capacity){
+        int new_capacity = table->capacity * 2;
+        while(id >= new_capacity){
+            new_capacity *= 2;
+        }
+        Literal *literals = arena_grow(table->arena, table->literals,
+            sizeof(Literal) * table->capacity, sizeof(Literal) * new_capacity);
+        if(literals == NULL){
+            return NULL;
+        }
+        table->literals = literals;
+        table->capacity = new_capacity;
+    }
+    return &table->literals[id];
+}
+
+// returns the id of the number, it's decoded the first time the spelling shows up
+// LITERAL_NONE if the system runs out of memory
+int literal_add_number(Literal_table *table, const char *spelling, int length){
+    int count = table->spellings->count;
+    int id = intern(table->spellings, spelling, length);
+    if(id == ATOM_NONE || id < count){
+        return id;
+    }
+
+    Literal *literal = reserve_literal(table, id);
+    if(literal == NULL){
+        return LITERAL_NONE;
+    }
+
+    literal->num_value = decode_number(spelling, length, &literal->is_integer);
+    literal->string_value = NULL;
+    literal->string_length = 0;
+
+    char operand[64];
+    int operand_length = snprintf(operand, sizeof(operand), "float@%a", literal->num_value);
+    literal->ifjcode = arena_strndup(table->arena, operand, operand_length);
+    if(literal->ifjcode == NULL){
+        return LITERAL_NONE;
+    }
+
+    return id;
+}
+
+// decodes the escapes the generator knows about, anything else is kept as it's written
+// the quotes around the string are dropped (one on each side, multiline strings keep the rest)
+static int decode_string(Arena *arena, const char *spelling, int length, Literal *literal){
+    if(length >= 2 && spelling[0] == '"' && spelling[length - 1] == '"'){
+        spelling++;
+        length -= 2;
+    }
+
+    char *value = arena_alloc(arena, length + 1);
+    if(value == NULL){
+        return 0;
+    }
+
+    int value_length = 0;
+    for(int i = 0; i < length; i++){
+        char c = spelling[i];
+        if(c == '\\' && i + 1 < length){
+            switch(spelling[i + 1]){
+                case 'n':  c = '\n'; i++; break;
+                case 't':  c = '\t'; i++; break;
+                case 'r':  c = '\r'; i++; break;
+                case '\\': c = '\\'; i++; break;
+                case '"':  c = '"';  i++; break;
+                case 'x':
+                    if(i + 3 < length && isxdigit((unsigned char)spelling[i + 2]) && isxdigit((unsigned char)spelling[i + 3])){
+                        char hex[3] = {spelling[i + 2], spelling[i + 3], '\0'};
+                        c = (char)strtol(hex, NULL, 16);
+                        i += 3;
+                    }
+                    break;
+            }
+        }
+        value[value_length++] = c;
+    }
+    value[value_length] = '\0';
+
+    literal->string_value = value;
+    literal->string_length = value_length;
+    return 1;
+}
+
+// IFJcode25 string operand, every byte that isn't plain printable ASCII becomes \ddd
+static char *encode_string(Arena *arena, const char *value, int length){
+    const char *prefix = "string@";
+    int prefix_length = strlen(prefix);
+
+    char *operand = arena_alloc(arena, prefix_length + 4 * length + 1);
+    if(operand == NULL){
+        return NULL;
+    }
+    memcpy(operand, prefix, prefix_length);
+
+    int position = prefix_length;
+    for(int i = 0; i < length; i++){
+        unsigned char c = value[i];
+        if(c <= ' ' || c > 126 || c == '#' || c == '\\'){
+            position += sprintf(operand + position, "\\%03d", c);
+        } else {
+            operand[position++] = c;
+        }
+    }
+    operand[position] = '\0';
+
+    return operand;
+}
+
+// returns the id of the string, it's decoded and encoded the first time the spelling shows up
+// LITERAL_NONE if the system runs out of memory
+int literal_add_string(Literal_table *table, const char *spelling, int length){
+    int count = table->spellings->count;
+    int id = intern(table->spellings, spelling, length);
+    if(id == ATOM_NONE || id < count){
+        return id;
+    }
+
+    Literal *literal = reserve_literal(table, id);
+    if(literal == NULL || !decode_string(table->arena, spelling, length, literal)){
+        return LITERAL_NONE;
+    }
+    literal->num_value = 0;
+    literal->is_integer = 0;
+
+    literal->ifjcode = encode_string(table->arena, literal->string_value, literal->string_length);
+    if(literal->ifjcode == NULL){
+        return LITERAL_NONE;
+    }
+
+    return id;
+}
+
+const Literal *literal_get(const Literal_table *table, int id){
+    return &table->literals[id];
+}
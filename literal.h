@@ -0,0 +1,35 @@
+#ifndef LITERAL_H
+#define LITERAL_H
+
+#include "intern.h"
+
+// tokens that aren't literals have this id
+#define LITERAL_NONE -1
+
+// what the lexer knows about a number or string literal,
+// every distinct spelling is decoded once and shared by all its tokens
+typedef struct literal {
+    // NUMBER
+    double num_value;
+    int is_integer;     // written without a fraction or an exponent (decimal or hex)
+
+    // STRING
+    char *string_value; // the bytes of the string, escapes decoded, NUL-terminated
+    int string_length;  // may contain NUL bytes
+
+    char *ifjcode;      // the literal as an IFJcode25 operand, "float@0x1p+0" or "string@a\032b"
+} Literal;
+
+typedef struct literal_table {
+    Arena *arena;
+    Intern_table *spellings;    // the id of a literal is the atom of its spelling
+    Literal *literals;
+    int capacity;
+} Literal_table;
+
+Literal_table *init_literal_table(Arena *arena);
+int literal_add_number(Literal_table *table, const char *spelling, int length);
+int literal_add_string(Literal_table *table, const char *spelling, int length);
+const Literal *literal_get(const Literal_table *table, int id);
+
+#endif
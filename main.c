@@ -1,19 +1,30 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "arena.h"
 #include "lexer.h"
+#include "source.h"
 #include "symtable.h"
 #include "syntactic.h"
 #include "semantic.h"
+#include "frozen.h"
 #include "generator.h"
 #include "utils.h"
 
 
 
-int main() {
-    Symtable *symtable;
-    symtable = init_sym_table();
-
+// runs the whole pipeline, everything it allocates lives in the arena
+static int compile(Source *source, Symtable *symtable, int streaming){
     // the lexer enters the initial state of the FSM
-    Lexer *lexer = init_lexer(symtable);
-    lexer_start(lexer);
+    // in streaming mode it's driven by the parser instead
+    Lexer *lexer = init_lexer(symtable, source);
+    if(lexer == NULL){
+        return ERR_T_MALLOC_ERR;
+    }
+    lexer->streaming = streaming;
+    if(!streaming){
+        lexer_start(lexer);
+    }
 
     if(lexer->error != 0){
         printf("lexer: %i\n", lexer->error);
@@ -22,36 +33,101 @@ int main() {
     
     // Syntactic analyser
     Syntactic *syntactic = init_syntactic(symtable);
+    if(syntactic == NULL){
+        return ERR_T_MALLOC_ERR;
+    }
     syntactic_start(syntactic, lexer);
 
-    int main_declared = check_main_function(syntactic->symtable);
-    if(main_declared != 0){
-        return main_declared;
+    if(lexer_finish(lexer) != 0){
+        printf("lexer: %i\n", lexer->error);
+        return lexer->error;
     }
 
+    // a declaration cut short by a syntax error leaves its arity unset,
+    // so main is only looked for once the whole program has parsed
     if(syntactic->error != 0){
          return syntactic->error;
     }
 
+    int main_declared = check_main_function(syntactic->symtable);
+    if(main_declared != 0){
+        return main_declared;
+    }
+
     Semantic *semantic = init_semantic(syntactic->symtable);
     traverse_tree(syntactic->tree->children[0], syntactic->symtable, semantic);
     if(semantic->error != 0){
          return semantic->error;
     } 
 
-    Generator *generator = init_generator(symtable);
+    // from here on the symbols are only read
+    const Frozen_symtable *frozen = symtable_freeze(symtable);
+    if (!frozen) {
+        return ERR_T_MALLOC_ERR;
+    }
+
+    Generator *generator = init_generator(frozen);
     if (!generator) {
         return ERR_T_MALLOC_ERR;
     }
     generate_global_vars(generator);
     
     int gen_error = generator_start(generator, syntactic->tree);
-    if (gen_error != 0) {
-        generator_free(generator);
-        return gen_error;
-    }
-    
     generator_free(generator);
 
-    return 0;
+    return gen_error;
+}
+
+int main(int argc, char **argv) {
+    char *source_path = NULL;
+    int streaming = 0;
+    int print_stats = 0;
+
+    // usage: main [--stream] [--symtable-stats] [input.ifj25]
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "--stream") == 0){
+            streaming = 1;
+        } else if(strcmp(argv[i], "--symtable-stats") == 0){
+            print_stats = 1;
+        } else {
+            source_path = argv[i];
+        }
+    }
+
+    // source file is given as an argument, otherwise it's read from stdin
+    Source *source = source_open(source_path);
+    if(source == NULL){
+        int open_error = errno;
+        perror(source_path != NULL ? source_path : "stdin");
+        return open_error == ENOMEM ? ERR_T_MALLOC_ERR : ERR_T_INTERNAL_ERR;
+    }
+
+    Arena *arena = arena_create();
+    if(arena == NULL){
+        source_close(source);
+        return ERR_T_MALLOC_ERR;
+    }
+
+    Symtable *symtable = init_sym_table(arena);
+    if(symtable == NULL){
+        arena_destroy(arena);
+        source_close(source);
+        return ERR_T_MALLOC_ERR;
+    }
+
+    int result = compile(source, symtable, streaming);
+
+    // the counters go to stderr, the program is on stdout
+    if(print_stats){
+#ifdef SYMTABLE_STATS
+        symtable_print_stats(symtable, stderr);
+#else
+        fprintf(stderr, "symtable stats are not built in, rebuild with make STATS=1\n");
+#endif
+    }
+
+    arena_destroy(arena);
+    source_close(source);
+
+    return result;
 }
@@ -0,0 +1,77 @@
+#include "scope.h"
+
+static int scope_index(int scope){
+    return scope == SCOPE_ROOT ? 0 : scope - SCOPE_ID_OFFSET;
+}
+
+Scope_tree *init_scope_tree(Arena *arena){
+    Scope_tree *scopes = arena_alloc(arena, sizeof(Scope_tree));
+    if(scopes == NULL){
+        return NULL;
+    }
+
+    scopes->arena = arena;
+    scopes->capacity = 64;
+    scopes->parents = arena_alloc(arena, sizeof(int) * scopes->capacity);
+    if(scopes->parents == NULL){
+        return NULL;
+    }
+
+    // the root is its own parent
+    scopes->parents[0] = SCOPE_ROOT;
+    scopes->count = 1;
+    scopes->is_chunk = 0;
+
+    return scopes;
+}
+
+Scope_tree *init_chunk_scope_tree(Arena *arena){
+    Scope_tree *scopes = init_scope_tree(arena);
+    if(scopes != NULL){
+        scopes->is_chunk = 1;
+    }
+
+    return scopes;
+}
+
+// adds a new block scope inside parent, returns its id or -1 if out of memory
+int scope_open(Scope_tree *scopes, int parent){
+    if(scopes->count == scopes->capacity){
+        int *parents = arena_grow(scopes->arena, scopes->parents,
+            sizeof(int) * scopes->capacity, sizeof(int) * scopes->capacity * 2);
+        if(parents == NULL){
+            return -1;
+        }
+        scopes->parents = parents;
+        scopes->capacity *= 2;
+    }
+
+    scopes->parents[scopes->count] = parent;
+
+    return SCOPE_ID_OFFSET + scopes->count++;
+}
+
+int scope_parent(const Scope_tree *scopes, int scope){
+    if(scopes->is_chunk && scope <= SCOPE_ROOT){
+        return scope - 1;
+    }
+
+    int index = scope_index(scope);
+    if(index < 0 || index >= scopes->count){
+        return SCOPE_ROOT;
+    }
+
+    return scopes->parents[index];
+}
+
+// checks if target is scope itself or one of the blocks enclosing it, the root doesn't count
+int scope_chain_contains(const Scope_tree *scopes, int scope, int target){
+    while(scope != SCOPE_ROOT){
+        if(scope == target){
+            return 1;
+        }
+        scope = scope_parent(scopes, scope);
+    }
+
+    return 0;
+}
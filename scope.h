@@ -0,0 +1,29 @@
+#ifndef SCOPE_H
+#define SCOPE_H
+
+#include "arena.h"
+
+// scope of everything outside of any block
+#define SCOPE_ROOT 0
+// block scopes are numbered from SCOPE_ID_OFFSET + 1 in the order their '{' is read
+#define SCOPE_ID_OFFSET 100
+
+// every block scope remembers only its parent, a token keeps just the id of its scope
+// and the chain of enclosing scopes is found by walking the parents
+typedef struct scope_tree {
+    Arena *arena;
+    int *parents;   // parents[id - SCOPE_ID_OFFSET], index 0 belongs to the root
+    int count;
+    int capacity;
+    // a chunk lexed on its own doesn't know the scope it starts in, its root stands for it
+    // and the scopes closed above it are numbered -1, -2, ... outwards
+    int is_chunk;
+} Scope_tree;
+
+Scope_tree *init_scope_tree(Arena *arena);
+Scope_tree *init_chunk_scope_tree(Arena *arena);
+int scope_open(Scope_tree *scopes, int parent);
+int scope_parent(const Scope_tree *scopes, int scope);
+int scope_chain_contains(const Scope_tree *scopes, int scope, int target);
+
+#endif
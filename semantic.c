@@ -154,7 +154,7 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
         return -1;
     }
     
-    char *func_name = node->children[0]->token->token_lexeme;
+    int func_atom = node->children[0]->token->atom;
     
     // get parameter count (second child should be gr_fun_param if it exists)
     int param_count = 0;
@@ -163,7 +163,7 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
     }
     
     // check each builtin function
-    if(strcmp(func_name, "write") == 0){
+    if(func_atom == ATOM_WRITE){
         if(param_count != 1){
             semantic->error = 5;
             return 5;
@@ -171,21 +171,21 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
 
         return 0;
     }
-    else if(strcmp(func_name, "read_str") == 0){
+    else if(func_atom == ATOM_READ_STR){
         if(param_count != 0){
             semantic->error = 5;
             return 5;
         }
         return 0;
     }
-    else if(strcmp(func_name, "read_num") == 0){
+    else if(func_atom == ATOM_READ_NUM){
         if(param_count != 0){
             semantic->error = 5;
             return 5;
         }
         return 0;
     }
-    else if(strcmp(func_name, "floor") == 0){
+    else if(func_atom == ATOM_FLOOR){
         if(param_count != 1){
             semantic->error = 5;
             return 5;
@@ -198,14 +198,14 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
         }
         return 0;
     }
-    else if(strcmp(func_name, "str") == 0){
+    else if(func_atom == ATOM_STR){
         if(param_count != 1){
             semantic->error = 5;
             return 5;
         }
         return 0;
     }
-    else if(strcmp(func_name, "length") == 0){
+    else if(func_atom == ATOM_LENGTH){
         if(param_count != 1){
             semantic->error = 5;
             return 5;
@@ -218,7 +218,7 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
         }
         return 0;
     }
-    else if(strcmp(func_name, "substring") == 0){
+    else if(func_atom == ATOM_SUBSTRING){
         if(param_count != 3){
             semantic->error = 5;
             return 5;
@@ -240,7 +240,7 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
         }
         return 0;
     }
-    else if(strcmp(func_name, "strcmp") == 0){
+    else if(func_atom == ATOM_STRCMP){
         if(param_count != 2){
             semantic->error = 5;
             return 5;
@@ -256,7 +256,7 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
         }
         return 0;
     }
-    else if(strcmp(func_name, "ord") == 0){
+    else if(func_atom == ATOM_ORD){
         if(param_count != 2){
             semantic->error = 5;
             return 5;
@@ -272,7 +272,7 @@ int check_builtin_function(tree_node_t *node, Semantic *semantic){
         }
         return 0;
     }
-    else if(strcmp(func_name, "chr") == 0){
+    else if(func_atom == ATOM_CHR){
         if(param_count != 1){
             semantic->error = 5;
             return 5;
@@ -316,18 +316,8 @@ int traverse_tree(tree_node_t *tree_node, Symtable *symtable, Semantic *semantic
                    tree_node->token &&
                    tree_node->token->token_type == TOKEN_T_IDENTIFIER) {
 
-            char *name = tree_node->token->token_lexeme;
             // Check if it's a builtin function identifier
-            if(strcmp(name, "write") == 0 ||
-               strcmp(name, "read_str") == 0 ||
-               strcmp(name, "read_num") == 0 ||
-               strcmp(name, "floor") == 0 ||
-               strcmp(name, "str") == 0 ||
-               strcmp(name, "length") == 0 ||
-               strcmp(name, "substring") == 0 ||
-               strcmp(name, "strcmp") == 0 ||
-               strcmp(name, "ord") == 0 ||
-               strcmp(name, "chr") == 0) {
+            if(atom_is_builtin_function(tree_node->token->atom)) {
 
                 return 0;
             }
@@ -344,24 +334,17 @@ int traverse_tree(tree_node_t *tree_node, Symtable *symtable, Semantic *semantic
                     }
                 }
 
-                Token *token = create_token(TOKEN_T_IDENTIFIER, symbol->sym_lexeme,symbol->sym_lexeme_length,
-            0,0,semantic->scope_counter+100, symbol->token->previous_scope_arr, symbol->token->scope_count);
-
-                add_prefix(token, "setter+");
-                if (search_table_for_setter_or_getter(token, symtable) != NULL) {
+                if (symtable_find_kind(symtable, IDENTIF_T_SETTER, symbol->sym_atom) != NULL) {
                     return 0;
                 }
 
-                token = create_token(TOKEN_T_IDENTIFIER, symbol->sym_lexeme,symbol->sym_lexeme_length,
-            0,0,semantic->scope_counter+100, symbol->token->previous_scope_arr, symbol->token->scope_count);
-                add_prefix(token, "getter+");
-                Symbol *getter_sym = search_table_for_setter_or_getter(token, symtable);
+                Symbol *getter_sym = symtable_find_kind(symtable, IDENTIF_T_GETTER, symbol->sym_atom);
                 if (getter_sym != NULL) {
-                    if (getter_sym->sym_identif_declaration_count)
+                    if (getter_sym->cold->sym_identif_declaration_count)
                     return 0;
                 }
 
-                if(symbol->sym_identif_declaration_count == 0){
+                if(symbol->cold->sym_identif_declaration_count == 0){
                     semantic->error = 3;
                     return semantic->error;
                 }else {
@@ -380,26 +363,14 @@ int traverse_tree(tree_node_t *tree_node, Symtable *symtable, Semantic *semantic
         }
 
 
-        if (symbol->sym_identif_declaration_count > 1 && symbol->sym_identif_type == IDENTIF_T_FUNCTION) {
-            int cnt = 0;
-            for (int i = 0; i < symbol->sym_identif_declaration_count; i++) {
-                for (int j = i + 1; j < symbol->sym_identif_declaration_count; j++) {
-                    if (symbol->sym_function_number_of_params[i] ==
-                        symbol->sym_function_number_of_params[j]) {
-                        
-                        cnt++;
-                    }
-                }
-            }
-            if(cnt > 1){
-                semantic->error = 4;
-                return semantic->error;
-            }
-        }else if(symbol->sym_identif_declaration_count > 1 && !symbol->is_parameter){
-            if(!multiple_declaration_valid(symbol)){
+        if (symbol->cold->sym_identif_declaration_count > 1 && symbol->sym_identif_type == IDENTIF_T_FUNCTION) {
+            if(symbol->cold->sym_function_redefined){
                 semantic->error = 4;
                 return semantic->error;
             }
+        }else if(symbol->cold->sym_variable_redeclared && !symbol->is_parameter){
+            semantic->error = 4;
+            return semantic->error;
         }
     } else { // nonterminal node
         if(tree_node->rule == GR_FUN_CALL && tree_node->children_count == 1){
@@ -408,15 +379,7 @@ int traverse_tree(tree_node_t *tree_node, Symtable *symtable, Semantic *semantic
                 return 0;
             }
 
-            bool found_param_count_match = false;
-            for(int i = 0;i<symbol->sym_identif_declaration_count;i++){
-                if(symbol->sym_function_number_of_params[i] == 0){
-                    found_param_count_match = true;
-                    break;
-                }
-            }
-
-            if(!found_param_count_match){
+            if(symbol_overload_index(symbol, 0) == -1){
                 print_symbol(symbol);
                 semantic->error = 5;
                 return semantic->error;
@@ -424,15 +387,7 @@ int traverse_tree(tree_node_t *tree_node, Symtable *symtable, Semantic *semantic
         }
         else if(tree_node->rule == GR_FUN_PARAM && tree_node->parent->rule == GR_FUN_CALL ){
             Symbol *symbol = search_table(tree_node->parent->children[0]->token, symtable);
-            bool found_param_count_match = false;
-            for(int i = 0;i<symbol->sym_identif_declaration_count;i++){
-                if(tree_node->children_count == symbol->sym_function_number_of_params[i]){
-                    found_param_count_match = true;
-                    break;
-                }
-            }
-            if(!found_param_count_match){
-                puts("daasa");
+            if(symbol_overload_index(symbol, tree_node->children_count) == -1){
                 semantic->error = 5;
                 return semantic->error;
             }
@@ -475,12 +430,13 @@ int traverse_tree(tree_node_t *tree_node, Symtable *symtable, Semantic *semantic
 
 Symbol *check_if_identif_is_parameter(Symbol *symbol, Semantic *semantic) {
     Symtable *symtable = semantic->symtable;
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        Symbol *sym = symtable->symtable_rows[i].symbol;
-        if (!sym || !sym->sym_lexeme || sym->sym_identif_declared_at_scope_arr == NULL) continue;
+    int position = -1;
+    Symbol *sym;
+    while ((sym = symtable_next_named(symtable, symbol->sym_atom, &position)) != NULL) {
+        if (sym->cold->sym_identif_declared_at_scope_arr == NULL ||
+            sym->sym_identif_type == IDENTIF_T_SETTER || sym->sym_identif_type == IDENTIF_T_GETTER) continue;
 
-        if (strcmp(sym->sym_lexeme, symbol->sym_lexeme) == 0 &&
-            symbol->sym_identif_used_at_scope_arr[0] == sym->sym_identif_declared_at_scope_arr[0]) {
+        if (symbol_first_use(symbol)->scope == sym->cold->sym_identif_declared_at_scope_arr[0]) {
             
             return sym;
         }
@@ -490,40 +446,21 @@ Symbol *check_if_identif_is_parameter(Symbol *symbol, Semantic *semantic) {
 
 }
 
-bool multiple_declaration_valid(Symbol *symbol){
-    for(int i = 0; i < symbol->sym_identif_declaration_count; i++){
-        for(int j = i + 1; j < symbol->sym_identif_declaration_count; j++){
-            // If two declarations are in the same scope, it's invalid
-            if(symbol->sym_identif_declared_at_scope_arr[i] == 
-               symbol->sym_identif_declared_at_scope_arr[j]){
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
 int check_main_function(Symtable *symtable) {
-    // Search through the entire symbol table for 'main'
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        Symbol *sym = symtable->symtable_rows[i].symbol;
-        if (!sym || !sym->sym_lexeme) continue;
-
-        // Check if this is 'main'
-        if (strcmp(sym->sym_lexeme, "main") == 0) {
-            if (sym->sym_identif_type != IDENTIF_T_FUNCTION) {
-                continue; 
-            }
+    // Search the symbols named 'main'
+    int position = -1;
+    Symbol *sym;
+    while ((sym = symtable_next_named(symtable, ATOM_MAIN, &position)) != NULL) {
+        if (sym->sym_identif_type != IDENTIF_T_FUNCTION) {
+            continue; 
+        }
 
-            // Check if any declaration has 0 parameters
-            for (int j = 0; j < sym->sym_identif_declaration_count; j++) {
-                if (sym->sym_function_number_of_params[j] == 0) {
-                    return 0; // Found main() with 0 parameters
-                }
-            }
-            
-            return 3; 
+        // Check if any declaration has 0 parameters
+        if (symbol_overload_index(sym, 0) != -1) {
+            return 0; // Found main() with 0 parameters
         }
+        
+        return 3; 
     }
 
     return 3; 
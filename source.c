@@ -0,0 +1,101 @@
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "source.h"
+
+// reads the whole descriptor into a heap buffer, block by block
+static int source_read_blocks(Source *source, int fd){
+    size_t capacity = SOURCE_READ_BLOCK_SIZE;
+    source->buffer = malloc(capacity);
+    if(source->buffer == NULL){
+        return 1;
+    }
+
+    for(;;){
+        if(source->length == capacity){
+            capacity *= 2;
+            char *new_buffer = realloc(source->buffer, capacity);
+            if(new_buffer == NULL){
+                return 1;
+            }
+            source->buffer = new_buffer;
+        }
+
+        ssize_t read_bytes = read(fd, source->buffer + source->length, capacity - source->length);
+        if(read_bytes < 0){
+            return 1;
+        }
+        if(read_bytes == 0){
+            return 0;
+        }
+        source->length += read_bytes;
+    }
+}
+
+// opens the source file, NULL path means stdin
+// regular files are mapped into memory, everything else is read in blocks
+// returns NULL with errno set if the source can't be read
+Source *source_open(const char *path){
+    Source *source = malloc(sizeof(Source));
+    if(source == NULL){
+        return NULL;
+    }
+
+    source->buffer = NULL;
+    source->length = 0;
+    source->is_mapped = 0;
+
+    int fd = STDIN_FILENO;
+    if(path != NULL){
+        fd = open(path, O_RDONLY);
+        if(fd < 0){
+            int open_error = errno;
+            free(source);
+            errno = open_error;
+            return NULL;
+        }
+    }
+
+    struct stat file_info;
+    if(fstat(fd, &file_info) == 0 && S_ISREG(file_info.st_mode) && file_info.st_size > 0){
+        void *mapping = mmap(NULL, file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED){
+            madvise(mapping, file_info.st_size, MADV_SEQUENTIAL);
+            source->buffer = mapping;
+            source->length = file_info.st_size;
+            source->is_mapped = 1;
+        }
+    }
+
+    if(!source->is_mapped && source_read_blocks(source, fd) != 0){
+        int read_error = errno;
+        if(path != NULL){
+            close(fd);
+        }
+        source_close(source);
+        errno = read_error;
+        return NULL;
+    }
+
+    if(path != NULL){
+        close(fd);
+    }
+
+    return source;
+}
+
+void source_close(Source *source){
+    if(source == NULL){
+        return;
+    }
+
+    if(source->is_mapped){
+        munmap(source->buffer, source->length);
+    } else {
+        free(source->buffer);
+    }
+    free(source);
+}
@@ -0,0 +1,18 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stddef.h>
+
+// size of one read() when the input can't be mapped (pipe, terminal)
+#define SOURCE_READ_BLOCK_SIZE 65536
+
+typedef struct source {
+    char *buffer;
+    size_t length;
+    int is_mapped;
+} Source;
+
+Source *source_open(const char *path);
+void source_close(Source *source);
+
+#endif
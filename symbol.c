@@ -3,28 +3,135 @@
 #include <stdio.h>
 #include "symbol.h"
 #include "token.h"
+#include "symtable_stats.h"
 
 
 // UTILS 
 
-void copy_lexeme_from_token_to_sym(Token *token, Symbol *symbol){
-    symbol->sym_lexeme = malloc(sizeof(char) * (symbol->sym_lexeme_length + 1));
-    memcpy(symbol->sym_lexeme, token->token_lexeme, symbol->sym_lexeme_length);
-    symbol->sym_lexeme[symbol->sym_lexeme_length] = '\0';
+void init_symbol_pool(Symbol_pool *pool, Arena *arena){
+    pool->arena = arena;
+    pool->block = NULL;
+    pool->cold_block = NULL;
+    pool->used = 0;
 }
 
-void init_identif_sym_arrays(Symbol *symbol, Token *token){
-    symbol->sym_identif_declared_at_line_arr = NULL;
-    symbol->sym_identif_declared_at_col_arr = NULL;
-    symbol->sym_identif_declared_at_scope_arr = NULL;
+// returns a zeroed symbol with its cold half, NULL if out of memory
+static Symbol *new_symbol(Symbol_pool *pool){
+    if(pool->block == NULL || pool->used == SYMBOL_POOL_BLOCK){
+        Symbol *block = arena_alloc(pool->arena, sizeof(Symbol) * SYMBOL_POOL_BLOCK);
+        Symbol_cold *cold_block = arena_alloc(pool->arena, sizeof(Symbol_cold) * SYMBOL_POOL_BLOCK);
+        if(block == NULL || cold_block == NULL){
+            return NULL;
+        }
+        pool->block = block;
+        pool->cold_block = cold_block;
+        pool->used = 0;
+    }
+
+    Symbol *symbol = &pool->block[pool->used];
+    memset(symbol, 0, sizeof(Symbol));
+    symbol->cold = &pool->cold_block[pool->used];
+    memset(symbol->cold, 0, sizeof(Symbol_cold));
+    pool->used++;
+    return symbol;
+}
+
+// makes room for one more entry in three parallel int arrays
+// the capacity doubles, so adding n entries costs O(n) in total
+// returns 0 if the system runs out of memory, the arrays are left as they were then
+static int reserve_occurence_arrays(Arena *arena, int count, int *capacity, int **line_arr, int **col_arr, int **scope_arr){
+    if(count < *capacity){
+        return 1;
+    }
+
+    SYMTABLE_STAT(declaration_growths++);
+    int new_capacity = *capacity == 0 ? 4 : *capacity * 2;
+    int *lines = arena_grow(arena, *line_arr, sizeof(int) * *capacity, sizeof(int) * new_capacity);
+    int *cols = arena_grow(arena, *col_arr, sizeof(int) * *capacity, sizeof(int) * new_capacity);
+    int *scopes = arena_grow(arena, *scope_arr, sizeof(int) * *capacity, sizeof(int) * new_capacity);
+    if(lines == NULL || cols == NULL || scopes == NULL){
+        return 0;
+    }
+    *line_arr = lines;
+    *col_arr = cols;
+    *scope_arr = scopes;
+    *capacity = new_capacity;
+    return 1;
+}
+
+// interned names are shared with the string pool, other lexemes get their own copy
+void copy_lexeme_from_token_to_sym(Arena *arena, Token *token, Symbol *symbol){
+    symbol->sym_atom = token->atom;
+    if(token->atom != ATOM_NONE){
+        symbol->sym_lexeme = token->token_lexeme;
+        return;
+    }
+    symbol->sym_lexeme = arena_strndup(arena, token->token_lexeme, symbol->sym_lexeme_length);
+}
+
+// appends a chunk for at least min_capacity records to the log, NULL if out of memory
+static Occurrence_chunk *append_chunk(Arena *arena, Occurrence_log *log, int min_capacity){
+    int capacity = log->last == NULL ? OCCURRENCE_FIRST_CHUNK : log->last->capacity * 2;
+    if(capacity > OCCURRENCE_MAX_CHUNK){
+        capacity = OCCURRENCE_MAX_CHUNK;
+    }
+    if(capacity < min_capacity){
+        capacity = min_capacity;
+    }
+
+    Occurrence_chunk *chunk = arena_alloc(arena, sizeof(Occurrence_chunk) + sizeof(Occurrence) * capacity);
+    if(chunk == NULL){
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->count = 0;
+    chunk->capacity = capacity;
+    SYMTABLE_STAT(occurrence_chunks++);
+
+    if(log->last == NULL){
+        log->first = chunk;
+    } else {
+        log->last->next = chunk;
+    }
+    log->last = chunk;
+    return chunk;
+}
+
+// a borrowed log gets its records copied into a chunk of its own before it's appended to,
+// the symbol it was borrowed from keeps writing into the old chain
+static int own_occurence_log(Arena *arena, Occurrence_log *log){
+    Occurrence_chunk *chunk = log->first;
+    int remaining = log->count;
+    SYMTABLE_STAT(occurrence_copies++);
 
-    symbol->sym_identif_used_at_line_arr = malloc(sizeof(int) * symbol->sym_identif_use_count);
-    symbol->sym_identif_used_at_col_arr = malloc(sizeof(int) * symbol->sym_identif_use_count);
-    symbol->sym_identif_used_at_scope_arr = malloc(sizeof(int) * symbol->sym_identif_use_count);
+    log->first = NULL;
+    log->last = NULL;
+    log->shared = false;
 
-    symbol->sym_identif_used_at_line_arr[0] = token->token_line_number;
-    symbol->sym_identif_used_at_col_arr[0] = token->token_col_number;
-    symbol->sym_identif_used_at_scope_arr[0] = token->scope;
+    Occurrence_chunk *copy = append_chunk(arena, log, remaining);
+    if(copy == NULL){
+        return 0;
+    }
+    for(; chunk != NULL && remaining > 0; chunk = chunk->next){
+        int n = chunk->count < remaining ? chunk->count : remaining;
+        memcpy(copy->records + copy->count, chunk->records, sizeof(Occurrence) * n);
+        copy->count += n;
+        remaining -= n;
+    }
+    return 1;
+}
+
+void init_identif_sym_arrays(Arena *arena, Symbol *symbol, Token *token, int token_index){
+    symbol->cold->sym_identif_declared_at_line_arr = NULL;
+    symbol->cold->sym_identif_declared_at_col_arr = NULL;
+    symbol->cold->sym_identif_declared_at_scope_arr = NULL;
+    symbol->cold->sym_identif_declaration_capacity = 0;
+
+    symbol->cold->sym_identif_uses.first = NULL;
+    symbol->cold->sym_identif_uses.last = NULL;
+    symbol->cold->sym_identif_uses.count = 0;
+    symbol->cold->sym_identif_uses.shared = false;
+    add_symbol_occurence(arena, symbol, token->token_line_number, token->token_col_number, token->scope, token_index);
 }
 
 void symbol_set_var_type(Token *token, Symbol *symbol){
@@ -43,144 +150,209 @@ void symbol_set_var_type(Token *token, Symbol *symbol){
 
 // INTERFACE FOR LEXER
 
-Symbol *lexer_create_identifier_sym_from_token(Token *token){
-    Symbol *symbol = malloc(sizeof(Symbol));
+Symbol *lexer_create_identifier_sym_from_token(Symbol_pool *pool, Token *token, int token_index){
+    Symbol *symbol = new_symbol(pool);
+    if(symbol == NULL){
+        return NULL;
+    }
     
     symbol->sym_type = SYM_T_IDENTIFIER;
     symbol->sym_identif_type = IDENTIF_T_UNSET;
     symbol->is_global = 0;
+    symbol->is_parameter = 0;
 
-    symbol->sym_function_number_of_params = NULL;
+    symbol->cold->sym_function_number_of_params = NULL;
 
     symbol->sym_variable_type = VAR_T_UNSET;
 
     symbol->sym_lexeme_length = token->lexeme_length;
-    copy_lexeme_from_token_to_sym(token, symbol);
+    copy_lexeme_from_token_to_sym(pool->arena, token, symbol);
 
-    symbol->sym_identif_declaration_count = 0;
-    symbol->sym_identif_use_count = 1;
+    symbol->cold->sym_identif_declaration_count = 0;
 
-    symbol->token = token;
+    // the token may live in the lexer's growing token table, keep a copy
+    symbol->cold->token = arena_alloc(pool->arena, sizeof(Token));
+    if(symbol->cold->token == NULL){
+        return NULL;
+    }
+    *symbol->cold->token = *token;
 
-    init_identif_sym_arrays(symbol, token);
+    init_identif_sym_arrays(pool->arena, symbol, token, token_index);
 
     return symbol;
 }
 
-Symbol *lexer_create_global_var_sym_from_token(Token *token){
-    Symbol *symbol = malloc(sizeof(Symbol));
+Symbol *lexer_create_global_var_sym_from_token(Symbol_pool *pool, Token *token, int token_index){
+    Symbol *symbol = new_symbol(pool);
+    if(symbol == NULL){
+        return NULL;
+    }
+
     symbol->sym_type = SYM_T_IDENTIFIER;
     symbol->sym_identif_type = IDENTIF_T_VARIABLE;
     symbol->is_global = 1;
+    symbol->is_parameter = 0;
+
+    symbol->cold->sym_function_number_of_params = NULL;
     
     symbol->sym_lexeme_length = token->lexeme_length;
-    copy_lexeme_from_token_to_sym(token, symbol);
+    copy_lexeme_from_token_to_sym(pool->arena, token, symbol);
 
-    symbol->sym_identif_declaration_count = 0;
-    symbol->sym_identif_use_count = 1;
-    init_identif_sym_arrays(symbol, token);
+    symbol->cold->sym_identif_declaration_count = 0;
+    init_identif_sym_arrays(pool->arena, symbol, token, token_index);
 
     return symbol;
 }
 
-Symbol *lexer_create_num_literal_sym_from_token(Token *token){
-    Symbol *symbol = malloc(sizeof(Symbol));
+Symbol *lexer_create_num_literal_sym_from_token(Symbol_pool *pool, Token *token, int token_index){
+    Symbol *symbol = new_symbol(pool);
+    if(symbol == NULL){
+        return NULL;
+    }
+
     symbol->sym_type = SYM_T_LITERAL;
-    symbol->sym_literal_type = LITERAL_T_NUM;
+    symbol->cold->sym_literal_type = LITERAL_T_NUM;
 
     symbol->sym_lexeme_length = token->lexeme_length;
-    copy_lexeme_from_token_to_sym(token, symbol);
+    copy_lexeme_from_token_to_sym(pool->arena, token, symbol);
 
-    symbol->sym_identif_declaration_count = 0;
-    symbol->sym_identif_use_count = 1;
-    init_identif_sym_arrays(symbol, token);
+    symbol->cold->sym_identif_declaration_count = 0;
+    init_identif_sym_arrays(pool->arena, symbol, token, token_index);
 
     return symbol;
 }
 
-Symbol *lexer_create_string_literal_sym_from_token(Token *token){
-    Symbol *symbol = malloc(sizeof(Symbol));
+Symbol *lexer_create_string_literal_sym_from_token(Symbol_pool *pool, Token *token, int token_index){
+    Symbol *symbol = new_symbol(pool);
+    if(symbol == NULL){
+        return NULL;
+    }
+
     symbol->sym_type = SYM_T_LITERAL;
-    symbol->sym_literal_type = LITERAL_T_STRING;
+    symbol->cold->sym_literal_type = LITERAL_T_STRING;
 
     symbol->sym_lexeme_length = token->lexeme_length;
-    copy_lexeme_from_token_to_sym(token, symbol);
+    copy_lexeme_from_token_to_sym(pool->arena, token, symbol);
 
-    symbol->sym_identif_declaration_count = 0;
-    symbol->sym_identif_use_count = 1;
-    init_identif_sym_arrays(symbol, token);
+    symbol->cold->sym_identif_declaration_count = 0;
+    init_identif_sym_arrays(pool->arena, symbol, token, token_index);
 
     return symbol;
 }
 
 // MODIFIERS FOR PARSER
 
-void add_symbol_occurence(Symbol *symbol, int line_number, int col_number, int scope){
-    symbol->sym_identif_use_count++;
+// O(1), the records already in the log are never copied again
+void add_symbol_occurence(Arena *arena, Symbol *symbol, int line_number, int col_number, int scope, int token_index){
+    Occurrence_log *log = &symbol->cold->sym_identif_uses;
+    if(log->shared && !own_occurence_log(arena, log)){
+        return;
+    }
 
-    symbol->sym_identif_used_at_line_arr = realloc(symbol->sym_identif_used_at_line_arr, sizeof(int) * symbol->sym_identif_use_count);
-    symbol->sym_identif_used_at_col_arr = realloc(symbol->sym_identif_used_at_col_arr, sizeof(int) * symbol->sym_identif_use_count);
-    symbol->sym_identif_used_at_scope_arr = realloc(symbol->sym_identif_used_at_scope_arr, sizeof(int) * symbol->sym_identif_use_count);
+    Occurrence_chunk *chunk = log->last;
+    if(chunk == NULL || chunk->count == chunk->capacity){
+        chunk = append_chunk(arena, log, 1);
+        if(chunk == NULL){
+            return;
+        }
+    }
 
-    symbol->sym_identif_used_at_line_arr[symbol->sym_identif_use_count - 1] = line_number;
-    symbol->sym_identif_used_at_col_arr[symbol->sym_identif_use_count - 1] = col_number;
-    symbol->sym_identif_used_at_scope_arr[symbol->sym_identif_use_count - 1] = scope;
+    Occurrence *occurrence = &chunk->records[chunk->count++];
+    occurrence->line = line_number;
+    occurrence->col = col_number;
+    occurrence->scope = scope;
+    occurrence->token_index = token_index;
+    log->count++;
 }
 
-void symbol_add_function_params_count(Symbol *symbol, int number_of_params){
-    if (symbol->sym_function_number_of_params == NULL){
-        symbol->sym_function_number_of_params = malloc(sizeof(int)*symbol->sym_identif_declaration_count);
-    } else {
-        symbol->sym_function_number_of_params = realloc(symbol->sym_function_number_of_params, sizeof(int)*symbol->sym_identif_declaration_count);
+// returns 0 if the system runs out of memory
+int add_symbol_declaration(Arena *arena, Symbol *symbol, int line_number, int col_number, int scope){
+    if(!reserve_occurence_arrays(arena, symbol->cold->sym_identif_declaration_count, &symbol->cold->sym_identif_declaration_capacity,
+        &symbol->cold->sym_identif_declared_at_line_arr, &symbol->cold->sym_identif_declared_at_col_arr, &symbol->cold->sym_identif_declared_at_scope_arr)){
+        return 0;
     }
 
-    if(symbol->sym_function_number_of_params == NULL){
+    int idx = symbol->cold->sym_identif_declaration_count++;
+    symbol->cold->sym_identif_declared_at_line_arr[idx] = line_number;
+    symbol->cold->sym_identif_declared_at_col_arr[idx] = col_number;
+    symbol->cold->sym_identif_declared_at_scope_arr[idx] = scope;
+    return 1;
+}
+
+// the parameter counts are indexed like the declarations,
+// the first declaration with a given count is the one calls resolve to
+// returns 0 if the system runs out of memory
+int symbol_add_function_params_count(Arena *arena, Symbol *symbol, int number_of_params){
+    Symbol_cold *cold = symbol->cold;
+    int old_size = sizeof(int) * cold->sym_function_params_capacity;
+    if(cold->sym_function_params_capacity < cold->sym_identif_declaration_capacity){
+        cold->sym_function_number_of_params = arena_grow(arena, cold->sym_function_number_of_params,
+            old_size, sizeof(int) * cold->sym_identif_declaration_capacity);
+        if(cold->sym_function_number_of_params == NULL){
+            return 0;
+        }
+        cold->sym_function_params_capacity = cold->sym_identif_declaration_capacity;
     }
-    symbol->sym_function_number_of_params[symbol->sym_identif_declaration_count-1] = number_of_params;
+
+    int index = cold->sym_identif_declaration_count - 1;
+    cold->sym_function_number_of_params[index] = number_of_params;
+
+    if(number_of_params >= cold->sym_function_arity_capacity){
+        int new_capacity = cold->sym_function_arity_capacity == 0 ? 4 : cold->sym_function_arity_capacity;
+        while(number_of_params >= new_capacity){
+            new_capacity *= 2;
+        }
+        int *by_arity = arena_grow(arena, cold->sym_function_overload_by_arity,
+            sizeof(int) * cold->sym_function_arity_capacity, sizeof(int) * new_capacity);
+        if(by_arity == NULL){
+            return 0;
+        }
+        for(int i = cold->sym_function_arity_capacity; i < new_capacity; i++){
+            by_arity[i] = -1;
+        }
+        cold->sym_function_overload_by_arity = by_arity;
+        cold->sym_function_arity_capacity = new_capacity;
+    }
+
+    if(cold->sym_function_overload_by_arity[number_of_params] == -1){
+        cold->sym_function_overload_by_arity[number_of_params] = index;
+    } else {
+        cold->sym_function_redefined = true;
+    }
+    return 1;
 }
 
-void copy_symbol_usage_info(Symbol *dest, Symbol *source) {
+// the destination borrows the source's chunks, it sees the uses the source has right now
+void copy_symbol_usage_info(Arena *arena, Symbol *dest, Symbol *source) {
+    (void)arena;
     if (dest == NULL || source == NULL) {
         return;
     }
 
-    // Free existing usage arrays in destination
-    if (dest->sym_identif_used_at_line_arr != NULL) {
-        free(dest->sym_identif_used_at_line_arr);
-    }
-    if (dest->sym_identif_used_at_col_arr != NULL) {
-        free(dest->sym_identif_used_at_col_arr);
-    }
-    if (dest->sym_identif_used_at_scope_arr != NULL) {
-        free(dest->sym_identif_used_at_scope_arr);
+    dest->cold->sym_identif_uses = source->cold->sym_identif_uses;
+    dest->cold->sym_identif_uses.shared = true;
+}
+
+#ifdef SYMTABLE_STATS
+// what the symbol holds in the arena, borrowed occurrence logs are counted by their owner
+size_t symbol_held_bytes(Symbol *symbol){
+    Symbol_cold *cold = symbol->cold;
+    size_t bytes = sizeof(Symbol) + sizeof(Symbol_cold);
+
+    if(cold->token != NULL){
+        bytes += sizeof(Token);
     }
+    bytes += 3 * sizeof(int) * cold->sym_identif_declaration_capacity;
+    bytes += sizeof(int) * (cold->sym_function_params_capacity + cold->sym_function_arity_capacity);
 
-    // Copy use count
-    dest->sym_identif_use_count = source->sym_identif_use_count;
-
-    // Allocate and copy usage arrays
-    if (source->sym_identif_use_count > 0) {
-        dest->sym_identif_used_at_line_arr = malloc(sizeof(int) * source->sym_identif_use_count);
-        dest->sym_identif_used_at_col_arr = malloc(sizeof(int) * source->sym_identif_use_count);
-        dest->sym_identif_used_at_scope_arr = malloc(sizeof(int) * source->sym_identif_use_count);
-
-        if (dest->sym_identif_used_at_line_arr != NULL &&
-            dest->sym_identif_used_at_col_arr != NULL &&
-            dest->sym_identif_used_at_scope_arr != NULL) {
-
-            memcpy(dest->sym_identif_used_at_line_arr, source->sym_identif_used_at_line_arr,
-                   sizeof(int) * source->sym_identif_use_count);
-            memcpy(dest->sym_identif_used_at_col_arr, source->sym_identif_used_at_col_arr,
-                   sizeof(int) * source->sym_identif_use_count);
-            memcpy(dest->sym_identif_used_at_scope_arr, source->sym_identif_used_at_scope_arr,
-                   sizeof(int) * source->sym_identif_use_count);
-            }
-    } else {
-        dest->sym_identif_used_at_line_arr = NULL;
-        dest->sym_identif_used_at_col_arr = NULL;
-        dest->sym_identif_used_at_scope_arr = NULL;
+    if(!cold->sym_identif_uses.shared){
+        for(Occurrence_chunk *chunk = cold->sym_identif_uses.first; chunk != NULL; chunk = chunk->next){
+            bytes += sizeof(Occurrence_chunk) + sizeof(Occurrence) * chunk->capacity;
+        }
     }
+    return bytes;
 }
+#endif
 
 void print_symbol(Symbol *symbol) {
 
@@ -211,8 +383,8 @@ void print_symbol(Symbol *symbol) {
             case IDENTIF_T_FUNCTION:
                 printf("Identif type: FUNCTION\n"); 
                 printf("PARAM COUNT: [");
-                for(int i = 0; i < symbol->sym_identif_declaration_count;i++){
-                    printf("%i,", symbol->sym_function_number_of_params[i]);
+                for(int i = 0; i < symbol->cold->sym_identif_declaration_count;i++){
+                    printf("%i,", symbol->cold->sym_function_number_of_params[i]);
                 }
                 printf("]\n");
                 break;
@@ -226,15 +398,19 @@ void print_symbol(Symbol *symbol) {
                 break;
             }
 
-        printf("Declaration count %i\n", symbol->sym_identif_declaration_count);
+        printf("Declaration count %i\n", symbol->cold->sym_identif_declaration_count);
 
-        for(int i = 0; i < symbol->sym_identif_declaration_count; i++) {
-            printf("Declared at: line %i col %i scope %i\n", symbol->sym_identif_declared_at_line_arr[i], symbol->sym_identif_declared_at_col_arr[i], symbol->sym_identif_declared_at_scope_arr[i]);
+        for(int i = 0; i < symbol->cold->sym_identif_declaration_count; i++) {
+            printf("Declared at: line %i col %i scope %i\n", symbol->cold->sym_identif_declared_at_line_arr[i], symbol->cold->sym_identif_declared_at_col_arr[i], symbol->cold->sym_identif_declared_at_scope_arr[i]);
         }
 
-        printf("Use count %i\n", symbol->sym_identif_use_count);
-        for(int i = 0; i < symbol->sym_identif_use_count; i++) {
-            printf("Used at: line %i col %i scope %i\n", symbol->sym_identif_used_at_line_arr[i], symbol->sym_identif_used_at_col_arr[i], symbol->sym_identif_used_at_scope_arr[i]);
+        printf("Use count %i\n", symbol->cold->sym_identif_uses.count);
+        int remaining = symbol->cold->sym_identif_uses.count;
+        for(Occurrence_chunk *chunk = symbol->cold->sym_identif_uses.first; chunk != NULL && remaining > 0; chunk = chunk->next) {
+            for(int i = 0; i < chunk->count && remaining > 0; i++, remaining--) {
+                Occurrence *use = &chunk->records[i];
+                printf("Used at: line %i col %i scope %i\n", use->line, use->col, use->scope);
+            }
         }
 
         // VARIABLE ... tbd
@@ -264,7 +440,7 @@ void print_symbol(Symbol *symbol) {
     }
 
     if(symbol->sym_type == SYM_T_LITERAL){
-        switch (symbol->sym_literal_type) {
+        switch (symbol->cold->sym_literal_type) {
             case LITERAL_T_NUM:
                 printf("Literal type: NUM\n");
                 break;
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 
 #include "token.h"
+#include "arena.h"
 
 typedef enum { 
     SYM_T_IDENTIFIER,         
@@ -31,36 +32,61 @@ typedef enum {
 } VARIABLE_TYPE;
 
 
-typedef struct symbol {
-    
-    SYMBOL_TYPE sym_type;
-    char *sym_lexeme;
-    int sym_lexeme_length;
-
-    // IDENTIF
-    IDENTIF_TYPE sym_identif_type;
-
+// symbols in one block of a Symbol_pool
+#define SYMBOL_POOL_BLOCK 256
+
+// records in the first chunk of an occurrence log, every next chunk doubles up to the max
+#define OCCURRENCE_FIRST_CHUNK 4
+#define OCCURRENCE_MAX_CHUNK 256
+
+// one use of an identifier
+typedef struct occurrence {
+    int line;
+    int col;
+    int scope;
+    int token_index;    // position of the token in the lexer's stream
+} Occurrence;
+
+// records are appended to the last chunk, a full chunk gets a bigger one after it,
+// written records never move
+typedef struct occurrence_chunk {
+    struct occurrence_chunk *next;
+    int count;
+    int capacity;
+    Occurrence records[];
+} Occurrence_chunk;
+
+typedef struct occurrence_log {
+    Occurrence_chunk *first;
+    Occurrence_chunk *last;
+    int count;      // records of this log, a shared chain may hold more after them
+    bool shared;    // the chunks are borrowed from another symbol, copied before appending
+} Occurrence_log;
+
+// what's only needed for declarations, diagnostics and code generation,
+// kept apart so the scans over symbols don't drag it through the cache
+typedef struct symbol_cold {
     Token *token;
 
     int sym_identif_declaration_count;
+    int sym_identif_declaration_capacity;
     int *sym_identif_declared_at_line_arr;
     int *sym_identif_declared_at_col_arr;
     int *sym_identif_declared_at_scope_arr;
 
-    int sym_identif_use_count;
-    int *sym_identif_used_at_line_arr;
-    int *sym_identif_used_at_col_arr;
-    int *sym_identif_used_at_scope_arr;
+    Occurrence_log sym_identif_uses;
 
     // VARIABLE
-    VARIABLE_TYPE sym_variable_type;
+    bool sym_variable_redeclared;           // declared twice in the same block
     float sym_variable_num_value;
     char *sym_variable_string_value;
-    int is_global;
-    bool is_parameter;
 
     // FUNCTION
     int *sym_function_number_of_params;
+    int sym_function_params_capacity;
+    int *sym_function_overload_by_arity;    // arity -> declaration index, -1 if there's none
+    int sym_function_arity_capacity;
+    bool sym_function_redefined;            // two declarations take the same number of params
     char ***sym_function_param_names;
     SYMBOL_TYPE *sym_function_param_types; 
 
@@ -68,22 +94,64 @@ typedef struct symbol {
     LITERAL_TYPE sym_literal_type;
     float sym_literal_num_value;
     char *sym_literal_string_value;
+} Symbol_cold;
 
+// the fields read on every lookup, 32 bytes on 64-bit targets
+typedef struct symbol {
+    char *sym_lexeme;
+    Symbol_cold *cold;
+    int sym_lexeme_length;
+    int sym_atom;       // atom of sym_lexeme, ATOM_NONE for literals
+
+    unsigned char sym_type;             // SYMBOL_TYPE
+    unsigned char sym_identif_type;     // IDENTIF_TYPE
+    unsigned char sym_variable_type;    // VARIABLE_TYPE
+    bool is_global;
+    bool is_parameter;
 } Symbol;
 
-void copy_lexeme_from_token_to_sym(Token *token, Symbol *symbol);
-void init_identif_sym_arrays(Symbol *symbol, Token *token);
+// symbols handed out one after another from blocks, the cold halves
+// sit at the same index of a parallel block
+typedef struct symbol_pool {
+    Arena *arena;
+    Symbol *block;
+    Symbol_cold *cold_block;
+    int used;
+} Symbol_pool;
+
+void init_symbol_pool(Symbol_pool *pool, Arena *arena);
+void copy_lexeme_from_token_to_sym(Arena *arena, Token *token, Symbol *symbol);
+void init_identif_sym_arrays(Arena *arena, Symbol *symbol, Token *token, int token_index);
 void print_symbol(Symbol *symbol);
-void copy_symbol_usage_info(Symbol *dest, Symbol *source);
+void copy_symbol_usage_info(Arena *arena, Symbol *dest, Symbol *source);
 
-Symbol *lexer_create_identifier_sym_from_token(Token *token);
-Symbol *lexer_create_global_var_sym_from_token(Token *token);
-Symbol *lexer_create_num_literal_sym_from_token(Token *token);
-Symbol *lexer_create_string_literal_sym_from_token(Token *token);
+Symbol *lexer_create_identifier_sym_from_token(Symbol_pool *pool, Token *token, int token_index);
+Symbol *lexer_create_global_var_sym_from_token(Symbol_pool *pool, Token *token, int token_index);
+Symbol *lexer_create_num_literal_sym_from_token(Symbol_pool *pool, Token *token, int token_index);
+Symbol *lexer_create_string_literal_sym_from_token(Symbol_pool *pool, Token *token, int token_index);
 
-void add_symbol_occurence(Symbol *symbol, int line_number, int col_number, int scope);
+void add_symbol_occurence(Arena *arena, Symbol *symbol, int line_number, int col_number, int scope, int token_index);
+int add_symbol_declaration(Arena *arena, Symbol *symbol, int line_number, int col_number, int scope);
 void symbol_set_var_type(Token *token, Symbol *symbol);
-void symbol_add_function_params_count(Symbol *symbol, int number_of_params);
+#ifdef SYMTABLE_STATS
+size_t symbol_held_bytes(Symbol *symbol);
+#endif
+int symbol_add_function_params_count(Arena *arena, Symbol *symbol, int number_of_params);
+
+// every identifier symbol starts with the occurrence it was created from
+static inline Occurrence *symbol_first_use(Symbol *symbol){
+    return &symbol->cold->sym_identif_uses.first->records[0];
+}
+
+// the declaration index of the overload taking arity params, -1 if there's none,
+// overloaded functions get the label name$index
+static inline int symbol_overload_index(const Symbol *symbol, int arity){
+    Symbol_cold *cold = symbol->cold;
+    if(arity < 0 || arity >= cold->sym_function_arity_capacity){
+        return -1;
+    }
+    return cold->sym_function_overload_by_arity[arity];
+}
 
 
 #endif
\ No newline at end of file
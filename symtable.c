@@ -2,25 +2,85 @@
 #include <string.h>
 #include <stdio.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "symtable.h"
 #include "symbol.h"
 
-Symtable *init_sym_table(){
+#ifdef SYMTABLE_STATS
+Symtable_stats symtable_stats;
+
+// a probe that started in first_group ended in group
+static void record_probe(Row_table *table, int first_group, int group){
+    int groups = ((group - first_group) & (table->size - 1)) / SYMTABLE_GROUP_SIZE + 1;
+    if (groups > SYMTABLE_STATS_PROBE_BUCKETS) {
+        groups = SYMTABLE_STATS_PROBE_BUCKETS;
+    }
+    symtable_stats.probes[groups - 1]++;
+}
+
+static void record_load(Symtable *symtable){
+    long inserts = symtable_stats.inserts;
+    if ((inserts & (inserts - 1)) != 0 || symtable_stats.sample_count == SYMTABLE_STATS_SAMPLES) {
+        return;
+    }
+    Symtable_load_sample *sample = &symtable_stats.samples[symtable_stats.sample_count++];
+    sample->inserts = inserts;
+    sample->entries = symtable->number_of_entries;
+    sample->size = symtable->rows.size;
+}
+#else
+#define record_probe(table, first_group, group) ((void)(first_group))
+#define record_load(symtable) ((void)0)
+#endif
+
+// rows start out empty, returns 0 if out of memory
+static int alloc_rows(Arena *arena, Row_table *table, int size){
+    table->control = arena_alloc(arena, size);
+    table->rows = arena_alloc(arena, sizeof(Symtable_row) * size);
+    if (table->control == NULL || table->rows == NULL) {
+        return 0;
+    }
+    memset(table->control, SYMTABLE_CTRL_EMPTY, size);
+    table->size = size;
+    return 1;
+}
+
+Symtable *init_sym_table(Arena *arena){
     Symtable *symtable = malloc(sizeof(Symtable));
     if(symtable == NULL) return NULL;
 
-    symtable->number_of_entries = 0;
-    symtable->symtable_size = 100;
-
-    symtable->symtable_rows = malloc(sizeof(Symtable_row) * symtable->symtable_size);
-    if (symtable->symtable_rows == NULL) {
+    symtable->arena = arena;
+    symtable->scopes = init_scope_tree(arena);
+    symtable->names = init_intern_table(arena);
+    symtable->literals = init_literal_table(arena);
+    if(symtable->scopes == NULL || symtable->names == NULL || symtable->literals == NULL ||
+        !intern_predefined(symtable->names)){
         free(symtable);
         return NULL;
     }
 
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        symtable->symtable_rows[i].key = 0;
-        symtable->symtable_rows[i].symbol = NULL;
+    init_symbol_pool(&symtable->symbol_pool, arena);
+    symtable->number_of_entries = 0;
+    symtable->symbols_capacity = 64;
+    symtable->symbols = arena_alloc(arena, sizeof(Symbol *) * symtable->symbols_capacity);
+    symtable->old_rows.control = NULL;
+    symtable->old_rows.size = 0;
+    symtable->old_count = 0;
+    symtable->rehash_index = 0;
+    symtable->by_kind_capacity = 0;
+    for (int i = 0; i < IDENTIF_T_UNSET; i++) {
+        symtable->by_kind[i] = NULL;
+    }
+    symtable->global_count = 0;
+    symtable->global_capacity = 16;
+    symtable->globals = arena_alloc(arena, sizeof(Symbol *) * symtable->global_capacity);
+    if (symtable->symbols == NULL || symtable->globals == NULL ||
+        !alloc_rows(arena, &symtable->rows, SYMTABLE_INITIAL_SIZE)) {
+        free(symtable);
+        return NULL;
     }
 
     return symtable;
@@ -37,184 +97,472 @@ int symtable_key_gen(char *seed){
     return (int)(hash & 0x7FFFFFFF);
 }
 
+// first row of the group the key's probing starts at, the key is mixed first
+// since names that differ only in the last character differ only in the low bits
+static int key_group(int key, int size){
+    unsigned mixed = (unsigned)key * 2654435761u;
+    unsigned groups = size / SYMTABLE_GROUP_SIZE;
+    return (int)(((unsigned long long)mixed * groups) >> 32) * SYMTABLE_GROUP_SIZE;
+}
+
 int symtable_index_gen(Symtable *symtable, int key){
-    return key % symtable->symtable_size;
+    return key_group(key, symtable->rows.size);
 }
 
-void insert_into_symtable(Symtable *symtable, Symbol *symbol){
-    int sym_key = symtable_key_gen(symbol->sym_lexeme);
-    int index = symtable_index_gen(symtable, sym_key);
+// the same key symtable_key_gen would give, the intern table hashed the name already
+static int symtable_atom_key(Symtable *symtable, int atom){
+    return (int)(symtable->names->hashes[atom] & 0x7FFFFFFF);
+}
 
-    // RESIZE
-    if(symtable->number_of_entries > symtable->symtable_size/2){
-        symtable->symtable_size = symtable->symtable_size * 2;
-        
-        symtable->symtable_rows = realloc(symtable->symtable_rows, symtable->symtable_size * sizeof(Symtable_row));
-        for (int i = symtable->symtable_size/2; i < symtable->symtable_size; i++) {
-            symtable->symtable_rows[i].key = 0;
-            symtable->symtable_rows[i].symbol = NULL;
+// bit i is set when control byte i of the group is byte
+static unsigned group_match(const unsigned char *control, unsigned char byte){
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i *)control);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < SYMTABLE_GROUP_SIZE; i++) {
+        if (control[i] == byte) {
+            mask |= 1u << i;
         }
     }
+    return mask;
+#endif
+}
 
-    // INSERTION LOGIC
-    if(symtable->symtable_rows[index].symbol == NULL){ // we have an empty slot,
-        symtable->symtable_rows[index].key = sym_key;
-        symtable->symtable_rows[index].symbol = symbol;
-        symtable->number_of_entries++;
-    } // we have a duplicate in the scope
-    else if(symtable->symtable_rows[index].symbol != NULL && 
-        strcmp(symtable->symtable_rows[index].symbol->sym_lexeme, symbol->sym_lexeme) == 0 && 
-        (symbol->sym_identif_used_at_scope_arr[0] == symtable->symtable_rows[index].symbol->sym_identif_used_at_scope_arr[0])
-    ){
+static int lowest_bit(unsigned mask){
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
 
-        add_symbol_occurence(symtable->symtable_rows[index].symbol, symbol->sym_identif_used_at_line_arr[0], symbol->sym_identif_used_at_col_arr[0], symbol->sym_identif_used_at_scope_arr[0]);
-    
+// the symbol goes to the first empty row of the first group that has one,
+// rows never become empty again, so later symbols of a name always come after the earlier ones
+static void place_row(Row_table *table, int key, Symbol *symbol){
+    int group = key_group(key, table->size);
+    unsigned empty;
+    while ((empty = group_match(table->control + group, SYMTABLE_CTRL_EMPTY)) == 0) {
+        group = (group + SYMTABLE_GROUP_SIZE) & (table->size - 1);
     }
-    else { // linear probing - also checking for duplicates
-        while(symtable->symtable_rows[index].symbol != NULL){
-            index = (index + 1) % symtable->symtable_size;
-            if(symtable->symtable_rows[index].symbol != NULL && 
-                strcmp(symtable->symtable_rows[index].symbol->sym_lexeme, symbol->sym_lexeme) == 0 && 
-                (symbol->sym_identif_used_at_scope_arr[0] == symtable->symtable_rows[index].symbol->sym_identif_used_at_scope_arr[0])
-            ){
-                add_symbol_occurence(symtable->symtable_rows[index].symbol, symbol->sym_identif_used_at_line_arr[0], symbol->sym_identif_used_at_col_arr[0], symbol->sym_identif_used_at_scope_arr[0]);
-                return;
+
+    int index = group + lowest_bit(empty);
+    table->control[index] = key & 0x7F;
+    table->rows[index].key = key;
+    table->rows[index].symbol = symbol;
+}
+
+// first row of the name at or after index on its probe sequence, -1 if there's none,
+// only rows whose control byte matches the key are looked at
+static int find_named(Row_table *table, int key, int atom, int index){
+    int group = index & ~(SYMTABLE_GROUP_SIZE - 1);
+    int first_group = group;
+    unsigned walked = (1u << (index - group)) - 1;
+    for (;;) {
+        const unsigned char *control = table->control + group;
+        unsigned matches = group_match(control, key & 0x7F) & ~walked;
+        while (matches) {
+            int row = group + lowest_bit(matches);
+            if (table->rows[row].key == key && table->rows[row].symbol->sym_atom == atom) {
+                record_probe(table, first_group, group);
+                return row;
             }
+            matches &= matches - 1;
+        }
+
+        // a name never goes past a group with an empty row
+        if (group_match(control, SYMTABLE_CTRL_EMPTY)) {
+            record_probe(table, first_group, group);
+            return -1;
         }
-        symtable->symtable_rows[index].key = sym_key;
-        symtable->symtable_rows[index].symbol = symbol;
-        symtable->number_of_entries++;
+        group = (group + SYMTABLE_GROUP_SIZE) & (table->size - 1);
+        walked = 0;
     }
+}
 
-    
+// moves every symbol of the name from the old rows into the new ones, oldest first
+static void move_name(Symtable *symtable, int key, int atom){
+    Row_table *old = &symtable->old_rows;
+    int index = find_named(old, key, atom, key_group(key, old->size));
+    while (index >= 0) {
+        place_row(&symtable->rows, key, old->rows[index].symbol);
+        old->control[index] = SYMTABLE_CTRL_DELETED;
+        symtable->old_count--;
+        SYMTABLE_STAT(rows_moved++);
+        index = find_named(old, key, atom, (index + 1) & (old->size - 1));
+    }
 
+    if (symtable->old_count == 0) {
+        old->control = NULL;
+    }
 }
 
-void print_symtable(Symtable *symtable) {
-    if (!symtable) return;
-    printf("============================================\n");
-    printf("==== Symbol table (%d entries, size %d): ===\n", symtable->number_of_entries, symtable->symtable_size);
-    printf("============================================\n");
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        if (symtable->symtable_rows[i].symbol != NULL) {
-            printf("-------- Index %d --------\n", i);
-            print_symbol(symtable->symtable_rows[i].symbol);
+// visits a few old rows, moving the names it finds
+static void rehash_step(Symtable *symtable, int budget){
+    while (symtable->old_rows.control != NULL && budget-- > 0) {
+        int index = symtable->rehash_index;
+        if (symtable->old_rows.control[index] < SYMTABLE_CTRL_EMPTY) {
+            Symtable_row *row = &symtable->old_rows.rows[index];
+            move_name(symtable, row->key, row->symbol->sym_atom);
         }
+        symtable->rehash_index = (index + 1) & (symtable->old_rows.size - 1);
     }
 }
 
-void print_symtable_lexemes(Symtable *symtable) {
-    if (!symtable) return;
-    printf("============================================\n");
-    printf("==== Symbol table (%d entries, size %d): ===\n", symtable->number_of_entries, symtable->symtable_size);
-    printf("============================================\n");
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        if (symtable->symtable_rows[i].symbol != NULL) {
-            printf("%s\n", symtable->symtable_rows[i].symbol->sym_lexeme);
-        }
+// the rows are doubled, the symbols move over a few at a time on the following inserts
+static int grow_rows(Symtable *symtable){
+    // the previous rehash is done by now unless inserts were few, it has to finish first
+    while (symtable->old_rows.control != NULL) {
+        rehash_step(symtable, symtable->old_rows.size);
     }
-}
 
-Symbol *search_table(Token *token, Symtable *symtable) {
+    Row_table rows;
+    if (!alloc_rows(symtable->arena, &rows, symtable->rows.size * 2)) {
+        return 0;
+    }
+    SYMTABLE_STAT(resizes++);
 
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        Symbol *sym = symtable->symtable_rows[i].symbol;
-        if (!sym || !sym->sym_lexeme) continue;
+    // the old rows stay in the arena
+    symtable->old_rows = symtable->rows;
+    if (symtable->number_of_entries == 0) {
+        symtable->old_rows.control = NULL;
+    }
+    symtable->old_count = symtable->number_of_entries;
+    symtable->rehash_index = 0;
+    symtable->rows = rows;
+    return 1;
+}
+
+// walks the symbols with the name of the atom, oldest first
+// start with *position = -1, positions past the size of the rows are in the old rows
+Symbol *symtable_next_named(Symtable *symtable, int atom, int *position){
+    SYMTABLE_STAT(next_named++);
+    if (atom == ATOM_NONE) {
+        return NULL;
+    }
 
-        for(int j = 0; j < token->scope_count; j++){
-            if (strcmp(sym->sym_lexeme, token->token_lexeme) == 0 && token->previous_scope_arr[j] == token->scope) {
-                return sym;
+    int key = symtable_atom_key(symtable, atom);
+    Row_table *rows = &symtable->rows;
+    Row_table *old = &symtable->old_rows;
+    int index;
+    if (*position < 0) {
+        // a name is either still in the old rows or already in the new ones
+        if (old->control != NULL) {
+            index = find_named(old, key, atom, key_group(key, old->size));
+            if (index >= 0) {
+                *position = rows->size + index;
+                return old->rows[index].symbol;
             }
         }
+        index = find_named(rows, key, atom, key_group(key, rows->size));
+    } else if (*position >= rows->size) {
+        index = find_named(old, key, atom, (*position - rows->size + 1) & (old->size - 1));
+        if (index >= 0) {
+            *position = rows->size + index;
+            return old->rows[index].symbol;
+        }
+    } else {
+        index = find_named(rows, key, atom, (*position + 1) & (rows->size - 1));
     }
 
-    return NULL;
+    if (index < 0) {
+        return NULL;
+    }
+    *position = index;
+    return rows->rows[index].symbol;
 }
 
-Symbol *search_table_for_setter_or_getter(Token *token, Symtable *symtable) {
+static int reserve_kind_index(Symtable *symtable, int atom){
+    if (atom < symtable->by_kind_capacity) {
+        return 1;
+    }
 
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        Symbol *sym = symtable->symtable_rows[i].symbol;
-        if (!sym || !sym->sym_lexeme) continue;
+    int old_capacity = symtable->by_kind_capacity;
+    int new_capacity = old_capacity ? old_capacity * 2 : 256;
+    while (atom >= new_capacity) {
+        new_capacity *= 2;
+    }
+    for (int i = 0; i < IDENTIF_T_UNSET; i++) {
+        Symbol **index = arena_grow(symtable->arena, symtable->by_kind[i],
+            sizeof(Symbol *) * old_capacity, sizeof(Symbol *) * new_capacity);
+        if (index == NULL) {
+            return 0;
+        }
+        memset(index + old_capacity, 0, sizeof(Symbol *) * (new_capacity - old_capacity));
+        symtable->by_kind[i] = index;
+    }
+    symtable->by_kind_capacity = new_capacity;
+    return 1;
+}
 
-        if (strcmp(sym->sym_lexeme, token->token_lexeme) == 0 ) {
-            return sym;
+static int add_global(Symtable *symtable, Symbol *symbol){
+    if (symtable->global_count == symtable->global_capacity) {
+        Symbol **globals = arena_grow(symtable->arena, symtable->globals,
+            sizeof(Symbol *) * symtable->global_capacity, sizeof(Symbol *) * symtable->global_capacity * 2);
+        if (globals == NULL) {
+            return 0;
         }
+        symtable->globals = globals;
+        symtable->global_capacity *= 2;
     }
+    symtable->globals[symtable->global_count++] = symbol;
+    return 1;
+}
 
-    return NULL;
+// finds the oldest symbol of the kind again once one of the symbol's name came in or changed kind,
+// returns 0 if the system runs out of memory
+static int refresh_kind(Symtable *symtable, Symbol *symbol, IDENTIF_TYPE type){
+    int atom = symbol->sym_atom;
+    if (type == IDENTIF_T_UNSET || atom == ATOM_NONE) {
+        return 1;
+    }
+    if (!reserve_kind_index(symtable, atom)) {
+        return 0;
+    }
+
+    Symbol *first = NULL;
+    int position = -1;
+    Symbol *sym;
+    while ((sym = symtable_next_named(symtable, atom, &position)) != NULL) {
+        if (sym->sym_identif_type == type && (type != IDENTIF_T_VARIABLE || sym->is_global)) {
+            first = sym;
+            break;
+        }
+    }
+
+    Symbol **index = symtable->by_kind[type];
+    if (type == IDENTIF_T_VARIABLE && index[atom] == NULL && first != NULL && !add_global(symtable, first)) {
+        return 0;
+    }
+    index[atom] = first;
+    return 1;
 }
 
-int identif_declared_at_least_once(Token *token, Symtable *symtable, bool is_param){
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        Symbol *sym = symtable->symtable_rows[i].symbol;
-        if (!sym || !sym->sym_lexeme) continue;
+// every change of kind goes through here so the indexes by kind stay right,
+// returns 0 if the system runs out of memory
+int symtable_set_identif_type(Symtable *symtable, Symbol *symbol, IDENTIF_TYPE type){
+    IDENTIF_TYPE old_type = symbol->sym_identif_type;
+    symbol->sym_identif_type = type;
+    return refresh_kind(symtable, symbol, old_type) && refresh_kind(symtable, symbol, type);
+}
 
-        // lexeme matches
-        if (strcmp(sym->sym_lexeme, token->token_lexeme) == 0) {
-            if (is_param) {
-                return 1;
-            }
+// the oldest symbol of the kind with the name
+Symbol *symtable_find_kind(Symtable *symtable, IDENTIF_TYPE type, int name_atom){
+    SYMTABLE_STAT(find_kind++);
+    if (name_atom < 0 || name_atom >= symtable->by_kind_capacity || type == IDENTIF_T_UNSET) {
+        return NULL;
+    }
+    return symtable->by_kind[type][name_atom];
+}
 
-            // check if symbol was previously declared in previous scopes
-            for(int j = token->scope_count - 1; j >= 0 ; j--){
-                for(int k = 0; k < sym->sym_identif_declaration_count; k++){
-                    if(token->previous_scope_arr[j] == sym->sym_identif_declared_at_scope_arr[k]){
-                        return 1;
-                    }
-                }
-            }
+// a setter and a getter go by the name of their property, the kind tells them apart
+static IDENTIF_TYPE key_kind(Symbol *symbol){
+    IDENTIF_TYPE type = symbol->sym_identif_type;
+    return type == IDENTIF_T_SETTER || type == IDENTIF_T_GETTER ? type : IDENTIF_T_UNSET;
+}
+
+// symbols are keyed by name, kind and the scope they were first used in,
+// returns 0 if the system runs out of memory
+int insert_into_symtable(Symtable *symtable, Symbol *symbol){
+    SYMTABLE_STAT(inserts++);
+    rehash_step(symtable, SYMTABLE_REHASH_STEP);
+
+    // we have a duplicate in the scope
+    int position = -1;
+    Symbol *sym;
+    while ((sym = symtable_next_named(symtable, symbol->sym_atom, &position)) != NULL) {
+        Occurrence *first = symbol_first_use(symbol);
+        if (first->scope == symbol_first_use(sym)->scope &&
+            key_kind(symbol) == key_kind(sym)) {
+            add_symbol_occurence(symtable->arena, sym, first->line, first->col, first->scope, first->token_index);
+            SYMTABLE_STAT(merged_inserts++);
+            record_load(symtable);
+            return 1;
         }
     }
 
-    return 0;
+    // RESIZE, at most 7/8 of the rows are taken
+    if (8 * (symtable->number_of_entries + 1) > 7 * symtable->rows.size && !grow_rows(symtable)) {
+        return 0;
+    }
+    if (symtable->number_of_entries == symtable->symbols_capacity) {
+        int new_capacity = symtable->symbols_capacity * 2;
+        Symbol **symbols = arena_grow(symtable->arena, symtable->symbols,
+            sizeof(Symbol *) * symtable->symbols_capacity, sizeof(Symbol *) * new_capacity);
+        if (symbols == NULL) {
+            return 0;
+        }
+        symtable->symbols = symbols;
+        symtable->symbols_capacity = new_capacity;
+    }
+
+    // older symbols of the name move first so they stay ahead of this one
+    int key = symtable_atom_key(symtable, symbol->sym_atom);
+    if (symtable->old_rows.control != NULL) {
+        move_name(symtable, key, symbol->sym_atom);
+    }
+
+    symtable->symbols[symtable->number_of_entries++] = symbol;
+    place_row(&symtable->rows, key, symbol);
+    record_load(symtable);
+
+    return refresh_kind(symtable, symbol, symbol->sym_identif_type);
+}
+
+void print_symtable(Symtable *symtable) {
+    if (!symtable) return;
+    printf("============================================\n");
+    printf("==== Symbol table (%d entries, size %d): ===\n", symtable->number_of_entries, symtable->rows.size);
+    printf("============================================\n");
+    // rows may be halfway through a rehash, the symbols are listed in the order they came in
+    for (int i = 0; i < symtable->number_of_entries; i++) {
+        printf("-------- Index %d --------\n", i);
+        print_symbol(symtable->symbols[i]);
+    }
+}
+
+void print_symtable_lexemes(Symtable *symtable) {
+    if (!symtable) return;
+    printf("============================================\n");
+    printf("==== Symbol table (%d entries, size %d): ===\n", symtable->number_of_entries, symtable->rows.size);
+    printf("============================================\n");
+    for (int i = 0; i < symtable->number_of_entries; i++) {
+        printf("%s\n", symtable->symbols[i]->sym_lexeme);
+    }
 }
 
-void symtable_add_declaration_info(Symbol *symbol, int line, int col, int scope) {
-    symbol->sym_identif_declaration_count++;
+// tokens the lexer didn't register (made up later on) are looked up by their spelling
+int symtable_token_atom(Symtable *symtable, Token *token) {
+    if (token->atom != ATOM_NONE || token->token_lexeme == NULL) {
+        return token->atom;
+    }
+    return intern_find(symtable->names, token->token_lexeme, strlen(token->token_lexeme));
+}
+
+Symbol *search_table(Token *token, Symtable *symtable) {
+    SYMTABLE_STAT(search_table++);
+    // the token's own scope has to be on its chain, which never holds for the root
+    if (!scope_chain_contains(symtable->scopes, token->scope, token->scope)) {
+        return NULL;
+    }
+
+    int position = -1;
+    return symtable_next_named(symtable, symtable_token_atom(symtable, token), &position);
+}
 
-    symbol->sym_identif_declared_at_line_arr = realloc(
-        symbol->sym_identif_declared_at_line_arr,
-        sizeof(int) * symbol->sym_identif_declaration_count
-    );
+int identif_declared_at_least_once(Token *token, Symtable *symtable, bool is_param){
+    int atom = symtable_token_atom(symtable, token);
+    int position = -1;
+    Symbol *sym;
+    while ((sym = symtable_next_named(symtable, atom, &position)) != NULL) {
+        if (is_param) {
+            return 1;
+        }
 
-    symbol->sym_identif_declared_at_col_arr = realloc(
-        symbol->sym_identif_declared_at_col_arr,
-        sizeof(int) * symbol->sym_identif_declaration_count
-    );
+        // check if symbol was previously declared in previous scopes
+        for(int k = 0; k < sym->cold->sym_identif_declaration_count; k++){
+            if(scope_chain_contains(symtable->scopes, token->scope, sym->cold->sym_identif_declared_at_scope_arr[k])){
+                return 1;
+            }
+        }
+    }
 
-    symbol->sym_identif_declared_at_scope_arr = realloc(
-        symbol->sym_identif_declared_at_scope_arr,
-        sizeof(int) * symbol->sym_identif_declaration_count
-    );
+    return 0;
+}
 
-    int idx = symbol->sym_identif_declaration_count - 1;
-    symbol->sym_identif_declared_at_line_arr[idx] = line;
-    symbol->sym_identif_declared_at_col_arr[idx] = col;
-    symbol->sym_identif_declared_at_scope_arr[idx] = scope;
+// returns 0 if the system runs out of memory
+int symtable_add_declaration_info(Symtable *symtable, Symbol *symbol, int line, int col, int scope) {
+    return add_symbol_declaration(symtable->arena, symbol, line, col, scope);
 }
 
 Symbol *search_table_in_scope_hierarchy(Token *token, Symtable *symtable) {
+    SYMTABLE_STAT(search_table_in_scope_hierarchy++);
     // First try exact scope match
     Symbol *result = search_table(token, symtable);
     if (result) return result;
     
     // If not found, search in all parent scopes for parameters
-    for (int i = 0; i < symtable->symtable_size; i++) {
-        Symbol *sym = symtable->symtable_rows[i].symbol;
-        if (!sym || !sym->sym_lexeme) continue;
-        
-        if (strcmp(sym->sym_lexeme, token->token_lexeme) == 0 && sym->is_parameter) {
+    int atom = symtable_token_atom(symtable, token);
+    int position = -1;
+    Symbol *sym;
+    while ((sym = symtable_next_named(symtable, atom, &position)) != NULL) {
+        if (sym->is_parameter) {
             // Check if this parameter's declaration scope is in the token's scope hierarchy
-            for (int j = 0; j < token->scope_count; j++) {
-                for (int k = 0; k < sym->sym_identif_declaration_count; k++) {
-                    if (token->previous_scope_arr[j] == sym->sym_identif_declared_at_scope_arr[k]) {
-                        return sym;
-                    }
+            for (int k = 0; k < sym->cold->sym_identif_declaration_count; k++) {
+                if (scope_chain_contains(symtable->scopes, token->scope, sym->cold->sym_identif_declared_at_scope_arr[k])) {
+                    return sym;
                 }
             }
         }
     }
     
     return NULL;
-}
\ No newline at end of file
+}
+#ifdef SYMTABLE_STATS
+// named after IDENTIF_TYPE, literals get the last one
+static const char *stats_kind_names[IDENTIF_T_UNSET + 2] = {
+    "variable", "function", "setter", "getter", "unset", "literal"
+};
+
+static void print_stats_longs(FILE *out, const long *values, int count){
+    for (int i = 0; i < count; i++) {
+        fprintf(out, i == 0 ? "%ld" : ", %ld", values[i]);
+    }
+}
+
+void symtable_print_stats(Symtable *symtable, FILE *out) {
+    Symtable_stats *stats = &symtable_stats;
+
+    long symbols[IDENTIF_T_UNSET + 2] = {0};
+    long bytes[IDENTIF_T_UNSET + 2] = {0};
+    for (int i = 0; i < symtable->number_of_entries; i++) {
+        Symbol *symbol = symtable->symbols[i];
+        int kind = symbol->sym_type == SYM_T_LITERAL ? IDENTIF_T_UNSET + 1 : symbol->sym_identif_type;
+        symbols[kind]++;
+        bytes[kind] += symbol_held_bytes(symbol);
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"entries\": %d,\n", symtable->number_of_entries);
+    fprintf(out, "  \"size\": %d,\n", symtable->rows.size);
+    fprintf(out, "  \"inserts\": %ld,\n", stats->inserts);
+    fprintf(out, "  \"merged_inserts\": %ld,\n", stats->merged_inserts);
+    fprintf(out, "  \"lookups\": {\"search_table\": %ld, \"search_table_in_scope_hierarchy\": %ld, "
+        "\"symtable_find_kind\": %ld, \"symtable_next_named\": %ld},\n",
+        stats->search_table, stats->search_table_in_scope_hierarchy, stats->find_kind, stats->next_named);
+    fprintf(out, "  \"snapshot_lookups\": {\"frozen_search\": %ld, \"frozen_find_kind\": %ld, \"frozen_named\": %ld},\n",
+        atomic_load(&stats->frozen_search), atomic_load(&stats->frozen_find_kind), atomic_load(&stats->frozen_named));
+
+    fprintf(out, "  \"probe_groups\": [");
+    print_stats_longs(out, stats->probes, SYMTABLE_STATS_PROBE_BUCKETS);
+    fprintf(out, "],\n");
+
+    fprintf(out, "  \"resizes\": %d,\n", stats->resizes);
+    fprintf(out, "  \"rows_moved\": %ld,\n", stats->rows_moved);
+    fprintf(out, "  \"load\": [");
+    for (int i = 0; i < stats->sample_count; i++) {
+        Symtable_load_sample *sample = &stats->samples[i];
+        fprintf(out, "%s{\"inserts\": %ld, \"entries\": %d, \"size\": %d, \"factor\": %.3f}",
+            i == 0 ? "" : ", ", sample->inserts, sample->entries, sample->size,
+            (double)sample->entries / sample->size);
+    }
+    fprintf(out, "],\n");
+
+    fprintf(out, "  \"occurrence_chunks\": %ld,\n", stats->occurrence_chunks);
+    fprintf(out, "  \"occurrence_copies\": %ld,\n", stats->occurrence_copies);
+    fprintf(out, "  \"declaration_growths\": %ld,\n", stats->declaration_growths);
+
+    fprintf(out, "  \"kinds\": {");
+    for (int kind = 0; kind < IDENTIF_T_UNSET + 2; kind++) {
+        fprintf(out, "%s\"%s\": {\"symbols\": %ld, \"bytes\": %ld}",
+            kind == 0 ? "" : ", ", stats_kind_names[kind], symbols[kind], bytes[kind]);
+    }
+    fprintf(out, "}\n}\n");
+}
+#endif
@@ -2,31 +2,77 @@
 #define SYMTABLE_H
 
 #include "symbol.h"
+#include "scope.h"
+#include "intern.h"
+#include "literal.h"
+#include "symtable_stats.h"
+
+#define SYMTABLE_INITIAL_SIZE 128
+// old rows looked at by every insert while the table grows
+#define SYMTABLE_REHASH_STEP 4
+
+// rows are probed a group at a time, a group's control bytes are compared at once
+#define SYMTABLE_GROUP_SIZE 16
+#define SYMTABLE_CTRL_EMPTY 0x80
+#define SYMTABLE_CTRL_DELETED 0xFE  // moved to the new rows, probing goes on past it
 
 typedef struct symtable_row {
-    int key;
+    int key;        // symtable_key_gen of the symbol's name
     Symbol *symbol;
 } Symtable_row;
 
+// open addressing by name, the symbols of a name are met in the order they were inserted
+typedef struct row_table {
+    unsigned char *control;     // a byte per row, empty, deleted or the low 7 bits of the key
+    Symtable_row *rows;
+    int size;                   // power of two, whole groups
+} Row_table;
+
 typedef struct symtable {
+    Arena *arena;   // symbols and everything they point to
+    Symbol_pool symbol_pool;    // where the lexer and the parser create symbols
+    Scope_tree *scopes;
+    Intern_table *names;    // atoms of every identifier and global variable
+    Literal_table *literals;
     int number_of_entries;
-    int symtable_size;
-    Symtable_row *symtable_rows;
+    Row_table rows;
+    // while the table grows, the names that haven't been moved yet
+    Row_table old_rows;         // control is NULL when nothing is left to move
+    int old_count;
+    int rehash_index;           // next old row to look at
+    Symbol **symbols;           // every symbol in the order it was inserted
+    int symbols_capacity;
+
+    // the oldest symbol of each kind by name, NULL if there's none,
+    // IDENTIF_T_VARIABLE holds just the global variables
+    Symbol **by_kind[IDENTIF_T_UNSET];
+    int by_kind_capacity;
+    Symbol **globals;           // one symbol per global variable name, in the order the names came in
+    int global_count;
+    int global_capacity;
 } Symtable;
 
 
 
-Symtable *init_sym_table();
+Symtable *init_sym_table(Arena *arena);
 int symtable_key_gen(char *seed);
 int symtable_index_gen(Symtable *symtable, int key);
-void insert_into_symtable(Symtable *symtable, Symbol *symbol);
+int insert_into_symtable(Symtable *symtable, Symbol *symbol);
+Symbol *symtable_next_named(Symtable *symtable, int atom, int *position);
+int symtable_set_identif_type(Symtable *symtable, Symbol *symbol, IDENTIF_TYPE type);
+Symbol *symtable_find_kind(Symtable *symtable, IDENTIF_TYPE type, int name_atom);
 void print_symtable(Symtable *symtable);
 void print_symtable_lexemes(Symtable *symtable);
+int symtable_token_atom(Symtable *symtable, Token *token);
 Symbol *search_table(Token *token, Symtable *symtable);
-void symtable_add_declaration_info(Symbol *symbol, int line, int col, int scope);
+int symtable_add_declaration_info(Symtable *symtable, Symbol *symbol, int line, int col, int scope);
 void add_function_param(Symbol *symbol, Token *token);
 int identif_declared_at_least_once(Token *token, Symtable *symtable, bool is_param);
-Symbol *search_table_for_setter_or_getter(Token *token, Symtable *symtable);
 Symbol *search_table_in_scope_hierarchy(Token *token, Symtable *symtable);
-void copy_symbol_usage_info(Symbol *dest, Symbol *source);
+void copy_symbol_usage_info(Arena *arena, Symbol *dest, Symbol *source);
+
+#ifdef SYMTABLE_STATS
+#include <stdio.h>
+void symtable_print_stats(Symtable *symtable, FILE *out);
+#endif
 #endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef SYMTABLE_STATS_H
+#define SYMTABLE_STATS_H
+
+// counters of what the symbol table is asked to do, built with make STATS=1
+// and printed as JSON by main --symtable-stats
+#ifdef SYMTABLE_STATS
+
+#include <stdatomic.h>
+
+// groups looked at by one probe, the last bucket takes the longer ones too
+#define SYMTABLE_STATS_PROBE_BUCKETS 16
+// the load is sampled whenever the number of inserts reaches a power of two
+#define SYMTABLE_STATS_SAMPLES 32
+
+typedef struct symtable_load_sample {
+    long inserts;
+    int entries;
+    int size;
+} Symtable_load_sample;
+
+typedef struct symtable_stats {
+    long inserts;
+    long merged_inserts;        // the name, kind and scope were there already, only a use was added
+
+    // lookups by the function they went through, the parser's,
+    // the generator only reads the frozen snapshot
+    long search_table;
+    long search_table_in_scope_hierarchy;
+    long find_kind;
+    long next_named;
+
+    // lookups in the frozen snapshot, which any number of threads may read at once
+    _Atomic long frozen_search;
+    _Atomic long frozen_find_kind;
+    _Atomic long frozen_named;
+
+    long probes[SYMTABLE_STATS_PROBE_BUCKETS];
+
+    int resizes;
+    long rows_moved;            // by the incremental rehash
+    Symtable_load_sample samples[SYMTABLE_STATS_SAMPLES];
+    int sample_count;
+
+    long occurrence_chunks;     // chunks added to occurrence logs
+    long occurrence_copies;     // borrowed logs copied before an append
+    long declaration_growths;   // declaration arrays that had to grow
+} Symtable_stats;
+
+extern Symtable_stats symtable_stats;
+
+#define SYMTABLE_STAT(update) ((void)(symtable_stats.update))
+// for the counters of the _Atomic fields, the count is all that matters, not the order
+#define SYMTABLE_STAT_SHARED(counter) \
+    ((void)atomic_fetch_add_explicit(&symtable_stats.counter, 1, memory_order_relaxed))
+
+#else
+
+#define SYMTABLE_STAT(update) ((void)0)
+#define SYMTABLE_STAT_SHARED(counter) ((void)0)
+
+#endif
+
+#endif
@@ -16,6 +16,11 @@ Syntactic *init_syntactic(Symtable *symtable){
 
     syntactic->symtable = symtable;
     syntactic->scope_counter = 0;
+    syntactic->env = init_scope_env(symtable->arena);
+    if(!syntactic->env){
+        free(syntactic);
+        return NULL;
+    }
     syntactic->fn_number_of_params = 0;
     tree_init(&syntactic->tree);
 
@@ -29,6 +34,14 @@ int syntactic_start(Syntactic *syntactic, Lexer *lexer){
     return syntactic->error;
 }
 
+// remembers which open block declares the var an identifier refers to, the generator
+// names the variable after that block
+static void resolve_identifier(Syntactic *syntactic, Token *token){
+    if(token && token->token_type == TOKEN_T_IDENTIFIER){
+        token->binding_scope = resolve(syntactic->env, token->atom);
+    }
+}
+
 // returns 1 on succes
 int assert_expected_literal(Syntactic *syntactic, Token* token, char *literal){
     if (!token) { syntactic->error = ERR_T_SYNTAX_ERR; return 0; };
@@ -110,6 +123,10 @@ int rule_code_block(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
 
     // increase scope
     syntactic->scope_counter++;
+    if(!enter_scope(syntactic->env)){
+        syntactic->error = ERR_T_MALLOC_ERR;
+        return syntactic->error;
+    }
 
     Token *current_token = get_next_token(lexer);
     if(!assert_expected_literal(syntactic, current_token, "{")){
@@ -147,6 +164,7 @@ int rule_code_block(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
 
     // decrease scope
     syntactic->scope_counter--;
+    exit_scope(syntactic->env);
 
     return syntactic->error;  
 }
@@ -240,20 +258,21 @@ int rule_instruction(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
     Token *lookahead_token = get_lookahead_token(lexer);
     if (!lookahead_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
 
-    if(strcmp(lookahead_token->token_lexeme, "return") == 0){
+    TOKEN_SUBTYPE subtype = lookahead_token->token_subtype;
+    if(subtype == SUB_T_RETURN){
         rule_return(syntactic, lexer, rule_instruction_node);
-    } else if(strcmp(lookahead_token->token_lexeme, "if") == 0){
+    } else if(subtype == SUB_T_IF){
         rule_if(syntactic, lexer, rule_instruction_node);
-    } else if(strcmp(lookahead_token->token_lexeme, "while") == 0){
+    } else if(subtype == SUB_T_WHILE){
         rule_while(syntactic, lexer, rule_instruction_node);
-    } else if(strcmp(lookahead_token->token_lexeme, "var") == 0){
+    } else if(subtype == SUB_T_VAR){
         rule_declaration(syntactic, lexer, rule_instruction_node);
     } else if(lookahead_token->token_type == TOKEN_T_IDENTIFIER || lookahead_token->token_type == TOKEN_T_GLOBAL_VAR){
         rule_assignment(syntactic, lexer, rule_instruction_node);
-    } else if(strcmp(lookahead_token->token_lexeme, "static") == 0){
+    } else if(subtype == SUB_T_STATIC){
         syntactic->fn_number_of_params = 0;
         rule_function_declaration_begin(syntactic, lexer, rule_instruction_node);
-    } else if(strcmp(lookahead_token->token_lexeme, "{") == 0){
+    } else if(subtype == SUB_T_LEFT_BRACE){
         rule_code_block(syntactic, lexer, rule_instruction_node);
     } else {
         syntactic->error = ERR_T_SYNTAX_ERR;
@@ -272,6 +291,7 @@ int rule_return(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
 
     // ZA RETURN NEMUSI BYT NIC
     Token *lookahead = get_lookahead_token(lexer);
+    if (!lookahead) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
     if(lookahead->token_type == TOKEN_T_EOL){
         return syntactic->error;
     }
@@ -381,13 +401,28 @@ int rule_declaration(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
     tree_node_t *indentif_node = tree_create_terminal(current_token);
     tree_insert_child(rule_declaration_node, indentif_node);
 
-    // HOTFIX
-    lexer->scope = syntactic->scope_counter;
+    // the declared name itself refers to what it shadows
+    resolve_identifier(syntactic, current_token);
 
     // update symbol table
     Symbol *symbol = search_table(current_token, syntactic->symtable);
-    symbol->sym_identif_type = IDENTIF_T_VARIABLE;
-    symtable_add_declaration_info(symbol, current_token->token_line_number, current_token->token_col_number, current_token->scope);
+    if(!symtable_set_identif_type(syntactic->symtable, symbol, IDENTIF_T_VARIABLE)){
+        syntactic->error = ERR_T_MALLOC_ERR;
+        return syntactic->error;
+    }
+    if(!symtable_add_declaration_info(syntactic->symtable, symbol, current_token->token_line_number, current_token->token_col_number, current_token->scope)){
+        syntactic->error = ERR_T_MALLOC_ERR;
+        return syntactic->error;
+    }
+    // the block already has a var of the name, the semantic pass reports it,
+    // globals go through the env too so they're caught the same way
+    if(resolve(syntactic->env, current_token->atom) == current_token->scope){
+        symbol->cold->sym_variable_redeclared = true;
+    }
+    if(!declare(syntactic->env, current_token->atom, current_token->scope)){
+        syntactic->error = ERR_T_MALLOC_ERR;
+        return syntactic->error;
+    }
     
     tree_insert_child(node, rule_declaration_node);
 
@@ -396,6 +431,7 @@ int rule_declaration(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
 
 int rule_allowed_eol(Syntactic *syntactic, Lexer *lexer) {
     Token *current_token = get_next_token(lexer);
+    if (!current_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
 
     if (strcmp(current_token->token_lexeme, ",") != 0 && current_token->token_type != TOKEN_T_OPERATOR) {
         syntactic->error = ERR_T_SYNTAX_ERR;
@@ -403,6 +439,7 @@ int rule_allowed_eol(Syntactic *syntactic, Lexer *lexer) {
     }
     // Allow one or more newlines after
     current_token = get_lookahead_token(lexer); // peek to see if there's a newline next
+    if (!current_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
     if (strcmp(current_token->token_lexeme, "\n") != 0) {
         return syntactic->error;
     }
@@ -427,9 +464,11 @@ int rule_assignment(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
         return syntactic->error;
     }
 
+    resolve_identifier(syntactic, current_token);
+
     // ADD OCCURENCE
     Symbol *symbol_to_update = search_table(current_token, syntactic->symtable); // identif
-    add_symbol_occurence(symbol_to_update, current_token->token_line_number, current_token->token_col_number, current_token->scope);
+    add_symbol_occurence(syntactic->symtable->arena, symbol_to_update, current_token->token_line_number, current_token->token_col_number, current_token->scope, lexer->token_index - 1);
 
     tree_node_t *identif_node = tree_create_terminal(current_token);
     tree_insert_child(rule_assignment_node, identif_node);
@@ -446,6 +485,7 @@ int rule_assignment(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
 
     // based on what to update
     Token *lookahead_token = get_lookahead_token(lexer);
+    if (!lookahead_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
 
     symbol_set_var_type(lookahead_token, symbol_to_update);
 
@@ -466,7 +506,7 @@ int rule_expression_or_function(Syntactic *syntactic, Lexer *lexer, tree_node_t
     Token *lookahead_token = get_lookahead_token(lexer);
     if (!lookahead_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
     
-    lexer->token_index--;
+    unget_token(lexer);
 
     if(current_token->token_type == TOKEN_T_STRING || current_token->token_type == TOKEN_T_NUM || current_token->token_type == TOKEN_T_GLOBAL_VAR){
         tree_node_t *exp_node = rule_expression(syntactic, lexer);
@@ -487,52 +527,6 @@ int rule_expression_or_function(Syntactic *syntactic, Lexer *lexer, tree_node_t
     return syntactic->error;
 }
 
-void add_prefix(Token *token, char *prefix) {
-    size_t prefix_len = strlen(prefix);
-    size_t old_len = token->lexeme_length;
-
-    token->lexeme_length = old_len + prefix_len;
-
-    char *new_ptr = realloc(token->token_lexeme,
-                            token->lexeme_length + 1);
-    if (!new_ptr) {
-        return;
-    }
-    token->token_lexeme = new_ptr;
-
-    memmove(token->token_lexeme + prefix_len,
-            token->token_lexeme,
-            old_len + 1);
-
-    memcpy(token->token_lexeme, prefix, prefix_len);
-}
-
-void add_prefix_to_symbol(Symbol *symbol, char *prefix) {
-    if (symbol == NULL || prefix == NULL) {
-        return;
-    }
-
-    size_t prefix_len = strlen(prefix);
-    size_t old_len = symbol->sym_lexeme_length;
-
-    symbol->sym_lexeme_length = old_len + prefix_len;
-
-    char *new_ptr = realloc(symbol->sym_lexeme, symbol->sym_lexeme_length + 1);
-    if (!new_ptr) {
-        return;
-    }
-
-    symbol->sym_lexeme = new_ptr;
-
-    // Move existing lexeme to make room for prefix
-    memmove(symbol->sym_lexeme + prefix_len,
-            symbol->sym_lexeme,
-            old_len + 1);
-
-    // Copy prefix to the beginning
-    memcpy(symbol->sym_lexeme, prefix, prefix_len);
-}
-
 int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_node_t *node){
     tree_node_t *rule_fn_dec_begin_node = tree_create_nonterminal(NONTERMINAL_T_DECLARATION, GR_FUN_DECLARATION);
 
@@ -544,6 +538,7 @@ int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_nod
         return syntactic->error;
     }
     current_token = get_next_token(lexer);
+    if (!current_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
     if(current_token->token_type != TOKEN_T_IDENTIFIER ){
         syntactic->error = ERR_T_SYNTAX_ERR;
         return syntactic->error;
@@ -558,9 +553,6 @@ int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_nod
 
     // function
     if(strcmp(lookahead_token->token_lexeme, "(") == 0){
-        // HOTFIX
-        lexer->scope = syntactic->scope_counter;
-
         // Find the original symbol created by lexer
         Symbol *original_symbol = search_table(current_token, syntactic->symtable);
 
@@ -570,19 +562,25 @@ int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_nod
         }
 
         // Mark it as a function and add declaration info
-        original_symbol->sym_identif_type = IDENTIF_T_FUNCTION;
-        symtable_add_declaration_info(original_symbol, current_token->token_line_number,
-                                       current_token->token_col_number, syntactic->scope_counter);
+        if (!symtable_set_identif_type(syntactic->symtable, original_symbol, IDENTIF_T_FUNCTION)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
+        if (!symtable_add_declaration_info(syntactic->symtable, original_symbol, current_token->token_line_number,
+                                           current_token->token_col_number, syntactic->scope_counter)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         syntactic->fn_number_of_params = 0;
         rule_function_declaration(syntactic, lexer, rule_fn_dec_begin_node);
 
-        symbol_add_function_params_count(original_symbol, syntactic->fn_number_of_params);
+        if (!symbol_add_function_params_count(syntactic->symtable->arena, original_symbol, syntactic->fn_number_of_params)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
     } else if (strcmp(lookahead_token->token_lexeme, "=") == 0) { // setter
-        // HOTFIX
-        lexer->scope = syntactic->scope_counter;
-
         // Find the original symbol created by lexer
         Symbol *original_symbol = search_table(current_token, syntactic->symtable);
 
@@ -592,26 +590,35 @@ int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_nod
         }
 
         // Create a new setter symbol with prefix
-        Symbol *setter_symbol = lexer_create_identifier_sym_from_token(current_token);
-        add_prefix_to_symbol(setter_symbol, "setter+");
+        Symbol *setter_symbol = lexer_create_identifier_sym_from_token(&syntactic->symtable->symbol_pool, current_token, lexer->token_index - 1);
+        if (setter_symbol == NULL) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         // Copy usage info from original symbol (where lexer put it)
-        copy_symbol_usage_info(setter_symbol, original_symbol);
+        copy_symbol_usage_info(syntactic->symtable->arena, setter_symbol, original_symbol);
 
         // Set setter-specific properties
-        setter_symbol->sym_identif_type = IDENTIF_T_SETTER;
-        symtable_add_declaration_info(setter_symbol, current_token->token_line_number,
-                                       current_token->token_col_number, syntactic->scope_counter);
+        if (!symtable_set_identif_type(syntactic->symtable, setter_symbol, IDENTIF_T_SETTER)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
+        if (!symtable_add_declaration_info(syntactic->symtable, setter_symbol, current_token->token_line_number,
+                                           current_token->token_col_number, syntactic->scope_counter)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         // Insert the setter symbol into symtable
-        insert_into_symtable(syntactic->symtable, setter_symbol);
+        if (!insert_into_symtable(syntactic->symtable, setter_symbol)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         rule_setter_declaration(syntactic, lexer, rule_fn_dec_begin_node);
 
     } else { // getter
-        // HOTFIX
-        lexer->scope = syntactic->scope_counter;
-
         // Find the original symbol created by lexer
         Symbol *original_symbol = search_table(current_token, syntactic->symtable);
 
@@ -621,19 +628,31 @@ int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_nod
         }
 
         // Create a new getter symbol with prefix
-        Symbol *getter_symbol = lexer_create_identifier_sym_from_token(current_token);
-        add_prefix_to_symbol(getter_symbol, "getter+");
+        Symbol *getter_symbol = lexer_create_identifier_sym_from_token(&syntactic->symtable->symbol_pool, current_token, lexer->token_index - 1);
+        if (getter_symbol == NULL) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         // Copy usage info from original symbol (where lexer put it)
-        copy_symbol_usage_info(getter_symbol, original_symbol);
+        copy_symbol_usage_info(syntactic->symtable->arena, getter_symbol, original_symbol);
 
         // Set getter-specific properties
-        getter_symbol->sym_identif_type = IDENTIF_T_GETTER;
-        symtable_add_declaration_info(getter_symbol, current_token->token_line_number,
-                                       current_token->token_col_number, syntactic->scope_counter);
+        if (!symtable_set_identif_type(syntactic->symtable, getter_symbol, IDENTIF_T_GETTER)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
+        if (!symtable_add_declaration_info(syntactic->symtable, getter_symbol, current_token->token_line_number,
+                                           current_token->token_col_number, syntactic->scope_counter)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         // Insert the getter symbol into symtable
-        insert_into_symtable(syntactic->symtable, getter_symbol);
+        if (!insert_into_symtable(syntactic->symtable, getter_symbol)) {
+            syntactic->error = ERR_T_MALLOC_ERR;
+            return syntactic->error;
+        }
 
         rule_getter_declaration(syntactic, lexer, rule_fn_dec_begin_node);
     }
@@ -744,6 +763,7 @@ int rule_function_parameters(Syntactic *syntactic, Lexer *lexer, tree_node_t *no
     tree_node_t *rule_function_parameters_node = tree_create_nonterminal(NONTERMINAL_T_FUN_PARAM, GR_FUN_PARAM);
     
     Token *lookahead_token = get_lookahead_token(lexer);
+    if (!lookahead_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
     
     if(strcmp(lookahead_token->token_lexeme, ")") == 0){
         return syntactic->error;
@@ -755,13 +775,17 @@ int rule_function_parameters(Syntactic *syntactic, Lexer *lexer, tree_node_t *no
     }
     else if(lookahead_token->token_type == TOKEN_T_IDENTIFIER){
         Token *t = get_next_token(lexer);
+        resolve_identifier(syntactic, t);
         Symbol *symbol = search_table(t, syntactic->symtable);
 
         tree_node_t *str_node = tree_create_terminal(t);
         tree_insert_child(rule_function_parameters_node, str_node);
 
         if(is_declaration){
-            symtable_add_declaration_info(symbol, t->token_line_number, t->token_col_number, syntactic->scope_counter+101);
+            if(!symtable_add_declaration_info(syntactic->symtable, symbol, t->token_line_number, t->token_col_number, syntactic->scope_counter+101)){
+                syntactic->error = ERR_T_MALLOC_ERR;
+                return syntactic->error;
+            }
             symbol->is_parameter = true;
         }
     }
@@ -785,6 +809,7 @@ int rule_function_parameters_prime(Syntactic *syntactic, Lexer *lexer, tree_node
     tree_node_t *rule_function_params_prime_node = node;
 
     Token *lookahead_token = get_lookahead_token(lexer);
+    if (!lookahead_token) { syntactic->error = ERR_T_SYNTAX_ERR; return syntactic->error = ERR_T_SYNTAX_ERR; };
 
     if (strcmp(lookahead_token->token_lexeme, ",") != 0) {
         return syntactic->error;
@@ -852,7 +877,10 @@ int rule_setter_declaration(Syntactic *syntactic, Lexer *lexer, tree_node_t *nod
         return 0;
     }
 
-    symtable_add_declaration_info(symbol, current_token->token_line_number, current_token->token_col_number, syntactic->scope_counter+101);
+    if(!symtable_add_declaration_info(syntactic->symtable, symbol, current_token->token_line_number, current_token->token_col_number, syntactic->scope_counter+101)){
+        syntactic->error = ERR_T_MALLOC_ERR;
+        return syntactic->error;
+    }
     symbol->is_parameter = true;
 
     tree_node_t *identif_node = tree_create_terminal(current_token);
@@ -877,38 +905,32 @@ int rule_setter_declaration(Syntactic *syntactic, Lexer *lexer, tree_node_t *nod
     return syntactic->error;
 }
 
-int is_binary_operator(Token *token){
-    if(!token) return 0;
-
-    if(token->token_type == TOKEN_T_OPERATOR && strcmp(token->token_lexeme, ".") != 0){
-        return 1;
-    }
-    return 0;
+// kind and subtype come from the token store, the parser doesn't have to touch the token
+int is_binary_operator(int kind, TOKEN_SUBTYPE subtype){
+    return kind == TOKEN_T_OPERATOR && subtype != SUB_T_DOT;
 }
 
-int get_operator_precedence(Token *token){
-
-    if(!token) return 0;
-
-    int op_priority;
-
-    char *op1 = token->token_lexeme;
-
-    if(strcmp(op1, "*") == 0 || strcmp(op1, "/") == 0){
-        op_priority = 5;
-    } else if (strcmp(op1, "+") == 0 || strcmp(op1, "-") == 0){
-        op_priority = 4;
-    } else if (strcmp(op1, "<") == 0 || strcmp(op1, ">") == 0 || strcmp(op1, "<=") == 0 || strcmp(op1, ">=") == 0){
-        op_priority = 3;
-    } else if (strcmp(op1, "is") == 0){
-        op_priority = 2;
-    } else if (strcmp(op1, "==") == 0 || strcmp(op1, "!=") == 0){
-        op_priority = 1;
-    } else {
-        return -1;
+int get_operator_precedence(TOKEN_SUBTYPE subtype){
+    switch(subtype){
+        case SUB_T_STAR:
+        case SUB_T_SLASH:
+            return 5;
+        case SUB_T_PLUS:
+        case SUB_T_MINUS:
+            return 4;
+        case SUB_T_LESS:
+        case SUB_T_GREATER:
+        case SUB_T_LESS_EQUAL:
+        case SUB_T_GREATER_EQUAL:
+            return 3;
+        case SUB_T_IS:
+            return 2;
+        case SUB_T_EQUAL:
+        case SUB_T_NOT_EQUAL:
+            return 1;
+        default:
+            return -1;
     }
-
-    return op_priority;
 }
 
 tree_node_t *rule_expression(Syntactic *syntactic, Lexer *lexer){
@@ -922,28 +944,34 @@ tree_node_t *rule_expression_1(tree_node_t *lhs, int min_precedence, Syntactic *
     Token *lookahead = get_lookahead_token(lexer);
     if (!lookahead) { syntactic->error = ERR_T_SYNTAX_ERR; return lhs; };
 
-    while (is_binary_operator(lookahead) && get_operator_precedence(lookahead) >= min_precedence) {
-        Token *op = lookahead;
-        get_next_token(lexer); // consume operator
+    int kind = lexer_lookahead_kind(lexer);
+    TOKEN_SUBTYPE subtype = lexer_lookahead_subtype(lexer);
+
+    while (is_binary_operator(kind, subtype) && get_operator_precedence(subtype) >= min_precedence) {
+        Token *op = get_next_token(lexer); // consume operator
+        if (!op) { syntactic->error = ERR_T_SYNTAX_ERR; return lhs; };
+        int op_precedence = get_operator_precedence(op->token_subtype);
 
         tree_node_t *rhs = rule_parse_primary(syntactic, lexer); 
         
         // ---------------------------------------------------
 
-        lookahead = get_lookahead_token(lexer);
+        kind = lexer_lookahead_kind(lexer);
+        subtype = lexer_lookahead_subtype(lexer);
 
-        while (is_binary_operator(lookahead) && get_operator_precedence(lookahead) > get_operator_precedence(op)) {
+        while (is_binary_operator(kind, subtype) && get_operator_precedence(subtype) > op_precedence) {
             
             int optional_increment;
-            if(get_operator_precedence(op) < get_operator_precedence(lookahead)){
+            if(op_precedence < get_operator_precedence(subtype)){
                 optional_increment = 1;
             } else {
                 optional_increment = 0;
             }
             
         
-            rhs = rule_expression_1(rhs, get_operator_precedence(op) + optional_increment, syntactic, lexer);
-            lookahead = get_lookahead_token(lexer);
+            rhs = rule_expression_1(rhs, op_precedence + optional_increment, syntactic, lexer);
+            kind = lexer_lookahead_kind(lexer);
+            subtype = lexer_lookahead_subtype(lexer);
         }
 
         // ---------------------------------------------------
@@ -965,6 +993,7 @@ tree_node_t *rule_expression_1(tree_node_t *lhs, int min_precedence, Syntactic *
 
 tree_node_t *rule_parse_primary(Syntactic *syntactic, Lexer *lexer) {
     Token *current_token = get_next_token(lexer);
+    if (!current_token) { syntactic->error = ERR_T_SYNTAX_ERR; return NULL; };
 
     tree_node_t *root;
     tree_init(&root);
@@ -986,6 +1015,7 @@ tree_node_t *rule_parse_primary(Syntactic *syntactic, Lexer *lexer) {
              current_token->token_type == TOKEN_T_IDENTIFIER || 
              current_token->token_type == TOKEN_T_GLOBAL_VAR ||
              current_token->token_type == TOKEN_T_KEYWORD ) {
+        resolve_identifier(syntactic, current_token);
         tree_node_t *node;
         tree_init(&node);
         node->token = current_token;
@@ -1002,6 +1032,7 @@ tree_node_t *rule_parse_primary(Syntactic *syntactic, Lexer *lexer) {
         tree_node_t *expr_node;
         tree_init(&expr_node);
         expr_node->token = get_next_token(lexer);
+        resolve_identifier(syntactic, expr_node->token);
 
         tree_insert_child(unary_node, expr_node);
 
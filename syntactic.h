@@ -4,12 +4,14 @@
 #include "lexer.h"
 #include "symtable.h"
 #include "tree.h"
+#include "env.h"
 
 typedef struct syntactic {
     int error;
     tree_node_t *tree;
     Symtable *symtable;
     int scope_counter;
+    Scope_env *env;     // var declarations of the open blocks
 
     int fn_number_of_params;
 } Syntactic;
@@ -54,7 +56,5 @@ int rule_function_parameters_prime(Syntactic *syntactic, Lexer *lexer, tree_node
 
 int rule_function_declaration_begin(Syntactic *syntactic, Lexer *lexer, tree_node_t *node);
 
-void add_prefix(Token *token, char *s);
-void add_prefix_to_symbol(Symbol *symbol, char *prefix);
 
 #endif
\ No newline at end of file
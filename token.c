@@ -4,42 +4,55 @@
 
 #include "token.h"
 
-Token *create_token(TOKEN_TYPE token_type, char *lexeme, int lexeme_length, int line_number, int col_number, int scope, int *previous_scope_arr, int scope_count) {
-    Token *token = malloc(sizeof(Token));
+// tokens with a fixed spelling point here instead of owning a copy
+char *token_spellings[SUB_T_COUNT] = {
+    [SUB_T_NONE] = NULL,
 
-    if (!token){
-        return NULL;
-    }
+    [SUB_T_CLASS] = "class", [SUB_T_IF] = "if", [SUB_T_ELSE] = "else", [SUB_T_IS] = "is",
+    [SUB_T_NULL] = "null", [SUB_T_RETURN] = "return", [SUB_T_VAR] = "var", [SUB_T_WHILE] = "while",
+    [SUB_T_IFJ] = "Ifj", [SUB_T_STATIC] = "static", [SUB_T_IMPORT] = "import", [SUB_T_FOR] = "for",
+    [SUB_T_NUM_TYPE] = "Num", [SUB_T_STRING_TYPE] = "String", [SUB_T_NULL_TYPE] = "Null",
 
-    token->token_type = token_type;
-    token->lexeme_length = lexeme_length;
-    token->token_line_number = line_number;
-    token->token_col_number = col_number - lexeme_length;
-    token->scope = scope;
+    [SUB_T_LEFT_PAREN] = "(", [SUB_T_RIGHT_PAREN] = ")", [SUB_T_LEFT_BRACE] = "{", [SUB_T_RIGHT_BRACE] = "}",
+    [SUB_T_COMMA] = ",", [SUB_T_PLUS] = "+", [SUB_T_MINUS] = "-", [SUB_T_STAR] = "*",
+    [SUB_T_SLASH] = "/", [SUB_T_DOT] = ".", [SUB_T_LESS] = "<", [SUB_T_GREATER] = ">",
+    [SUB_T_ASSIGN] = "=", [SUB_T_LESS_EQUAL] = "<=", [SUB_T_GREATER_EQUAL] = ">=",
+    [SUB_T_EQUAL] = "==", [SUB_T_NOT_EQUAL] = "!=",
+
+    [SUB_T_EOL] = "\n"
+};
 
-    token->scope_count = scope_count;
-    token->previous_scope_arr = malloc(scope_count * sizeof(int));
+// creates a token that owns a copy of its lexeme, for tokens that don't come from the source
+Token *create_token(Arena *arena, TOKEN_TYPE token_type, char *lexeme, int lexeme_length, int line_number, int col_number, int scope) {
+    Token *token = arena_alloc(arena, sizeof(Token));
 
-    for(int i = 0; i < scope_count; i++){
-        token->previous_scope_arr[i] = previous_scope_arr[i];
+    if (!token){
+        return NULL;
     }
 
-    token->token_lexeme = malloc(sizeof(char) * (lexeme_length + 1));
-    
+    init_token(token, token_type, -1, lexeme_length, line_number, col_number, scope);
+
+    token->token_lexeme = arena_strndup(arena, lexeme, lexeme_length);
     if(token->token_lexeme == NULL){
-        free(token);
         return NULL;
     }
 
-    memcpy(token->token_lexeme, lexeme, lexeme_length);
-    token->token_lexeme[lexeme_length] = '\0';
-
     return token;
 }
 
-void free_token(Token *token){
-    free(token->token_lexeme);
-    free(token);
+// fills in a token whose lexeme stays in the source buffer
+void init_token(Token *token, TOKEN_TYPE token_type, int lexeme_offset, int lexeme_length, int line_number, int col_number, int scope){
+    token->token_type = token_type;
+    token->token_subtype = SUB_T_NONE;
+    token->token_lexeme = NULL;
+    token->lexeme_offset = lexeme_offset;
+    token->lexeme_length = lexeme_length;
+    token->token_line_number = line_number;
+    token->token_col_number = col_number - lexeme_length;
+    token->scope = scope;
+    token->atom = ATOM_NONE;
+    token->literal = LITERAL_NONE;
+    token->binding_scope = BINDING_UNRESOLVED;
 }
 
 void print_token(Token *token){
@@ -48,12 +61,6 @@ void print_token(Token *token){
     printf("Length: %i\n", token->lexeme_length);
     printf("Line:   %i\n", token->token_line_number);
     printf("Col:    %i\n", token->token_col_number);
-    printf("Scope count:    %i\n", token->scope_count);
-    printf("Scope arr:      ");
-    for(int i = 0; i < token->scope_count; i++){
-        printf("%i ", token->previous_scope_arr[i]);
-    }
-
-    printf("\n");
+    printf("Scope:  %i\n", token->scope);
     printf("\n");
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include "arena.h"
+#include "literal.h"
+
 typedef enum {
     TOKEN_T_IDENTIFIER,  
     TOKEN_T_NUM,  
@@ -13,19 +16,77 @@ typedef enum {
     TOKEN_T_EOL
 } TOKEN_TYPE;
 
+// tokens with a fixed spelling, spelled by token_spellings
+typedef enum {
+    SUB_T_NONE,         // the lexeme comes from the source
+
+    // keywords
+    SUB_T_CLASS,
+    SUB_T_IF,
+    SUB_T_ELSE,
+    SUB_T_IS,
+    SUB_T_NULL,
+    SUB_T_RETURN,
+    SUB_T_VAR,
+    SUB_T_WHILE,
+    SUB_T_IFJ,
+    SUB_T_STATIC,
+    SUB_T_IMPORT,
+    SUB_T_FOR,
+    SUB_T_NUM_TYPE,
+    SUB_T_STRING_TYPE,
+    SUB_T_NULL_TYPE,
+
+    // operators and brackets
+    SUB_T_LEFT_PAREN,
+    SUB_T_RIGHT_PAREN,
+    SUB_T_LEFT_BRACE,
+    SUB_T_RIGHT_BRACE,
+    SUB_T_COMMA,
+    SUB_T_PLUS,
+    SUB_T_MINUS,
+    SUB_T_STAR,
+    SUB_T_SLASH,
+    SUB_T_DOT,
+    SUB_T_LESS,
+    SUB_T_GREATER,
+    SUB_T_ASSIGN,
+    SUB_T_LESS_EQUAL,
+    SUB_T_GREATER_EQUAL,
+    SUB_T_EQUAL,
+    SUB_T_NOT_EQUAL,
+
+    SUB_T_EOL,
+    SUB_T_COUNT
+} TOKEN_SUBTYPE;
+
+#define SUB_T_FIRST_KEYWORD SUB_T_CLASS
+#define SUB_T_LAST_KEYWORD SUB_T_NULL_TYPE
+#define SUB_T_FIRST_PUNCTUATION SUB_T_LEFT_PAREN
+#define SUB_T_LAST_PUNCTUATION SUB_T_NOT_EQUAL
+
+extern char *token_spellings[SUB_T_COUNT];
+
+// binding_scope of a token the parser didn't resolve, and of a name no open block declares
+#define BINDING_UNRESOLVED -2
+#define BINDING_NONE -1
+
 typedef struct token {
     TOKEN_TYPE token_type;
-    char *token_lexeme;
+    TOKEN_SUBTYPE token_subtype;
+    char *token_lexeme;     // NUL-terminated lexeme, NULL until somebody needs it
+    int lexeme_offset;      // start of the lexeme in the source buffer, -1 if it isn't from the source
     int lexeme_length;
     int token_line_number;
     int token_col_number;
-    int scope;
-    int scope_count;
-    int *previous_scope_arr;
+    int scope;      // the enclosing scopes are found through the scope tree
+    int atom;       // interned name of identifiers and global variables, ATOM_NONE otherwise
+    int literal;    // id in the literal table for numbers and strings, LITERAL_NONE otherwise
+    int binding_scope;  // block of the var declaration the identifier refers to
 } Token;
 
-Token *create_token(TOKEN_TYPE token_type, char *lexeme, int lexeme_length, int line_number, int col_number, int scope, int *previous_scope_arr, int scope_count);
+Token *create_token(Arena *arena, TOKEN_TYPE token_type, char *lexeme, int lexeme_length, int line_number, int col_number, int scope);
+void init_token(Token *token, TOKEN_TYPE token_type, int lexeme_offset, int lexeme_length, int line_number, int col_number, int scope);
 void print_token(Token *token);
-void free_token(Token *token);
 
 #endif
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "symbol.h"
+#include "scope.h"
 
 
 tree_node_t *tree_create_nonterminal(nonterminal_types nonterminal_type, grammar_rules rule) {
@@ -19,6 +20,8 @@ tree_node_t *tree_create_nonterminal(nonterminal_types nonterminal_type, grammar
     if (!node->token) return NULL;
 
     const char *rule_str = grammar_rule_to_string(rule);
+    init_token(node->token, TOKEN_T_KEYWORD, -1, 0, 0, 0, SCOPE_ROOT);
+    node->token->lexeme_length = strlen(rule_str);
     node->token->token_lexeme = malloc(strlen(rule_str) + 1);
     if (!node->token->token_lexeme) {
         free(node->token);
@@ -37,8 +40,9 @@ tree_node_t *tree_create_terminal(Token *token){
     node->token = token;    
     node->children_count = 0;
 
+    // newline lexemes are shared, so point to another string instead of rewriting it
     if(strcmp(token->token_lexeme, "\n") == 0){
-        strcpy(node->token->token_lexeme, "n");
+        node->token->token_lexeme = "n";
     }
 
     return node;
@@ -11,7 +11,8 @@ typedef enum {
     ERR_T_SEMANTIC_ERR_OTHER = 10,
     ERR_T_SEMANTIC_ERR_BUILTIN_FN_BAD_PARAM = 25,
     ERR_T_SEMANTIC_ERR_BUILTIN_FN_BAD_OPERAND_TYPES = 26,
-    ERR_T_MALLOC_ERR = 99
+    ERR_T_MALLOC_ERR = 99,
+    ERR_T_INTERNAL_ERR = 99     // anything else the input program can't cause, like an unreadable file
 
 } ERROR_TYPES;
 